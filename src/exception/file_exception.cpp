@@ -3,3 +3,6 @@
 
 FileNotFound::FileNotFound(const std::string &path) : logic_error(path + " not found.") {
 }
+
+InvalidFile::InvalidFile(const std::string &path) : logic_error(path + " is corrupted or has an unknown format.") {
+}
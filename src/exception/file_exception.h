@@ -23,5 +23,18 @@ public:
     explicit FileNotFound(const std::string& path);
 };
 
+/**
+ * Class relative to the exception of a file whose contents are corrupted or in an unknown format.
+ */
+class InvalidFile : public std::logic_error{
+public:
+    /**
+     * Creates a new InvalidFile exception object.
+     *
+     * @param path the file path
+     */
+    explicit InvalidFile(const std::string& path);
+};
+
 
 #endif //FEUP_AEDA_PROJECT_FILEEXCEPTION_H
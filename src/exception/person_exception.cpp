@@ -9,6 +9,10 @@ PersonDoesNotExist::PersonDoesNotExist(unsigned long taxID) :
     std::logic_error("Person with number " + std::to_string(taxID) + " does not exist!"){
 }
 
+PersonAlreadyExists::PersonAlreadyExists(unsigned long taxID) :
+    std::logic_error("Person with number " + std::to_string(taxID) + " already exists!"){
+}
+
 InvalidPersonPosition::InvalidPersonPosition(unsigned long position, unsigned long size) :
     std::invalid_argument(std::to_string(position + 1) + " is an invalid position; should be between 1 and " + std::to_string(size) + "!"){
 }
@@ -28,6 +28,19 @@ public:
     explicit PersonDoesNotExist(unsigned long taxID);
 };
 
+/**
+ * Class relative to the exception of a taxpayer identification number which is already in use.
+ */
+class PersonAlreadyExists: public std::logic_error{
+public:
+    /**
+     * Creates a new PersonAlreadyExists exception object.
+     *
+     * @param taxID the taxpayer identification number
+     */
+    explicit PersonAlreadyExists(unsigned long taxID);
+};
+
 /**
  * Class relative to the exception of an invalid person position on some list.
  */
@@ -35,12 +35,14 @@ int enableVTProcessing(){
 }
 
 /**
- * Create a blank store to be displayed in the UI. Show the UI.
+ * Recover the store from the last session, or create a blank one, to be displayed in the UI. Show the UI.
  * @return code execution error
  */
 int main() {
     enableVTProcessing();
     Store s;
-    IntroMenu menu(s);
+    std::string recovery = s.recover(Store::DEFAULT_SNAPSHOT_PATH, Store::DEFAULT_JOURNAL_PATH);
+    recovery += "\n" + s.openArchive(Store::DEFAULT_ARCHIVE_PATH);
+    IntroMenu menu(s, recovery);
     menu.show();
 }
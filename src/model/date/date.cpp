@@ -1,22 +1,74 @@
 
 #include "date.h"
-#include <iomanip>
 
-Date::Date() :
-    _time{0,0,0,1,1} {
-    time_t t = std::time(nullptr);
-    localtime_r(&t, &_time);
+#include <ctime>
+
+namespace {
+    /**
+     * The number of minutes of a day.
+     */
+    const std::int32_t MINUTES_PER_DAY = 24 * 60;
+
+    /**
+     * Writes a number with a fixed number of digits, padded with zeros.
+     *
+     * @param n the number
+     * @param width the number of digits
+     * @param str where the digits are written
+     */
+    void writeDigits(int n, int width, char* str) {
+        bool negative = n < 0;
+        unsigned value = negative ? 0u - static_cast<unsigned>(n) : static_cast<unsigned>(n);
+        for (int i = width - 1; i >= 0; --i, value /= 10) str[i] = static_cast<char>('0' + value % 10);
+        if (negative) str[0] = '-';
+    }
+
+    /**
+     * Gets the number of whole days of a number of minutes, rounding towards the past.
+     *
+     * @param minutes the number of minutes
+     * @return the number of days
+     */
+    std::int32_t floorDays(std::int32_t minutes) {
+        return minutes >= 0 ? minutes / MINUTES_PER_DAY : -((-minutes - 1) / MINUTES_PER_DAY) - 1;
+    }
+}
+
+Date::Date() : _minutes(0) {
+    std::time_t t = std::time(nullptr);
+    std::tm time{};
+    localtime_r(&t, &time);
+    _minutes = daysFromCivil(time.tm_year + 1900, static_cast<unsigned>(time.tm_mon + 1),
+                             static_cast<unsigned>(time.tm_mday)) * MINUTES_PER_DAY + time.tm_hour * 60 + time.tm_min;
+}
+
+Date::Date(int day, int month, int year, int hour, int minute) : _minutes(0) {
+    if (!isValid(day, month, year, hour, minute)) {
+        char str[16];
+        format(day, month, year, hour, minute, str);
+        throw InvalidDate(std::string(str, sizeof(str)));
+    }
+    _minutes = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * MINUTES_PER_DAY
+            + hour * 60 + minute;
 }
 
-Date::Date(int day, int month, int year, int hour, int minute) :
-    _time(){
-    _time.tm_hour = hour;
-    _time.tm_min = minute;
-    _time.tm_year = year - 1900;
-    _time.tm_mon = month - 1;
-    _time.tm_mday = day;
-    _time.tm_isdst = -1; // determine daylight saving flag
-    if (!isValid()) throw InvalidDate(getCompleteDate());
+bool Date::parse(const char *calendarDay, const char *clockTime, Date &date) {
+    const auto digit = [](const char* c) { return static_cast<unsigned>(*c - '0'); };
+    const unsigned digits[] = {
+            digit(calendarDay), digit(calendarDay + 1), digit(calendarDay + 3), digit(calendarDay + 4),
+            digit(calendarDay + 6), digit(calendarDay + 7), digit(calendarDay + 8), digit(calendarDay + 9),
+            digit(clockTime), digit(clockTime + 1), digit(clockTime + 3), digit(clockTime + 4)
+    };
+
+    // characters below '0' wrap around, so a single comparison per digit catches every non digit
+    unsigned invalid = (calendarDay[2] != '/') | (calendarDay[5] != '/') | (clockTime[2] != ':');
+    for (unsigned d : digits) invalid |= d > 9;
+    if (invalid) return false;
+
+    date = Date(static_cast<int>(digits[0] * 10 + digits[1]), static_cast<int>(digits[2] * 10 + digits[3]),
+                static_cast<int>(digits[4] * 1000 + digits[5] * 100 + digits[6] * 10 + digits[7]),
+                static_cast<int>(digits[8] * 10 + digits[9]), static_cast<int>(digits[10] * 10 + digits[11]));
+    return true;
 }
 
 bool Date::isLeapYear(unsigned year) {
@@ -24,75 +76,92 @@ bool Date::isLeapYear(unsigned year) {
 }
 
 std::string Date::getCalendarDay() const {
-    std::ostringstream os;
-    os << std::right << std::setfill('0') << std::setw(2) << getDay()
-    << '/' << std::setw(2) << getMonth() <<
-    '/' << std::setw(4) << getYear();
-    return os.str();
+    return getCompleteDate().substr(0, 10);
 }
 
 std::string Date::getClockTime() const {
-    std::ostringstream os;
-    os << std::right << std::setfill('0') << std::setw(2) << getHour()
-       << ':' << std::setw(2) << getMinute();
-    return os.str();
+    return getCompleteDate().substr(11);
 }
 
 std::string Date::getCompleteDate() const {
-    return getCalendarDay() + " " + getClockTime();
+    CivilDay civil = getCivilDay();
+    char str[16];
+    format(static_cast<int>(civil.day), static_cast<int>(civil.month), civil.year, static_cast<int>(getHour()),
+           static_cast<int>(getMinute()), str);
+    return std::string(str, sizeof(str));
+}
+
+std::int32_t Date::getMinutes() const {
+    return _minutes;
+}
+
+std::int32_t Date::getDays() const {
+    return floorDays(_minutes);
 }
 
 bool Date::operator==(const Date &d2) const {
-    return getCompleteDate() == d2.getCompleteDate();
+    return _minutes == d2._minutes;
 }
 
 bool Date::operator<(const Date &d2) const {
-    return getCompleteDate() < d2.getCompleteDate();
+    return _minutes < d2._minutes;
 }
 
-
-bool Date::isValid() const {
-    if (getHour()>=24 || getMinute()>=60 || getDay()>31 || getMonth() > 12) return false;
-    switch(getMonth()){
+bool Date::isValid(int day, int month, int year, int hour, int minute) {
+    if (hour < 0 || hour >= 24 || minute < 0 || minute >= 60 || day < 1 || day > 31 || month < 1 || month > 12)
+        return false;
+    // beyond these, the minutes since 1970 overflow
+    if (year < MIN_YEAR || year > MAX_YEAR) return false;
+    switch(month){
         case 4: case 6: case 9: case 11:
-            return getDay()<=30;
+            return day<=30;
         case 2:
-            return isLeapYear(getYear()) ? getDay()<=29 : getDay()<=28;
+            return isLeapYear(static_cast<unsigned>(year)) ? day<=29 : day<=28;
         default:
             return true;
     }
 }
 
+void Date::format(int day, int month, int year, int hour, int minute, char *str) {
+    writeDigits(day, 2, str);
+    str[2] = '/';
+    writeDigits(month, 2, str + 3);
+    str[5] = '/';
+    writeDigits(year, 4, str + 6);
+    str[10] = ' ';
+    writeDigits(hour, 2, str + 11);
+    str[13] = ':';
+    writeDigits(minute, 2, str + 14);
+}
+
+Date::CivilDay Date::getCivilDay() const {
+    return civilFromDays(floorDays(_minutes));
+}
+
 void Date::addDays(int days) {
-    _time.tm_mday += days;
-    std::time_t ntime = mktime(&_time);
-    localtime_r(&ntime,&_time);
+    _minutes += days * MINUTES_PER_DAY;
+}
+
+void Date::addMinutes(int minutes) {
+    _minutes += minutes;
 }
 
 unsigned Date::getMonth() const {
-    return (unsigned) _time.tm_mon + 1;
+    return getCivilDay().month;
 }
 
 unsigned Date::getDay() const {
-    return (unsigned) _time.tm_mday;
+    return getCivilDay().day;
 }
 
 unsigned Date::getYear() const {
-    return (unsigned) _time.tm_year + 1900;
+    return static_cast<unsigned>(getCivilDay().year);
 }
 
 unsigned Date::getHour() const {
-    return (unsigned) _time.tm_hour;
+    return static_cast<unsigned>(_minutes - floorDays(_minutes) * MINUTES_PER_DAY) / 60;
 }
 
 unsigned Date::getMinute() const {
-    return (unsigned) _time.tm_min;
-}
-
-void Date::addMinutes(int minutes) {
-    _time.tm_min += minutes;
-    std::time_t ntime = mktime(&_time);
-    localtime_r(&ntime,&_time);
+    return static_cast<unsigned>(_minutes - floorDays(_minutes) * MINUTES_PER_DAY) % 60;
 }
-
-
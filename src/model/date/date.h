@@ -2,13 +2,15 @@
 #ifndef FEUP_AEDA_PROJECT_DATE_H
 #define FEUP_AEDA_PROJECT_DATE_H
 
+#include <cstdint>
 #include <string>
-#include <ctime>
 
 #include "exception/date_exception.h"
 
 /**
  * Class that provides the date to order request and its delivery.
+ * The date is kept as the number of minutes since the 1st of January of 1970, so that it takes 4 bytes, is compared
+ * with a single integer comparison and is moved forward with an addition; the calendar fields are computed from it.
  */
 class Date{
 public:
@@ -22,12 +24,45 @@ public:
      *
      * @param day the day
      * @param month the month
-     * @param year the year
+     * @param year the year, from MIN_YEAR to MAX_YEAR
      * @param hour the hour
      * @param minute the minute
+     * @throws InvalidDate if the date doesn't exist or its year is out of range
      */
     Date(int day, int month, int year, int hour = 0, int minute = 0);
 
+    /**
+     * Parses a date from its calendar day, in DD/MM/YYYY format, and its clock time, in HH:MM format, straight from
+     * the characters, without copying them.
+     *
+     * @param calendarDay the pointer to the CALENDAR_DAY_SIZE characters of the calendar day
+     * @param clockTime the pointer to the CLOCK_TIME_SIZE characters of the clock time
+     * @param date the date where the result is saved; unchanged, if the format doesn't match
+     * @return true, if the format matches; false, otherwise
+     * @throws InvalidDate if the format matches but the date doesn't exist or its year is out of range
+     */
+    static bool parse(const char* calendarDay, const char* clockTime, Date& date);
+
+    /**
+     * The first year of a date.
+     */
+    static const int MIN_YEAR = 0;
+
+    /**
+     * The last year of a date, the last whole one whose minutes since 1970 fit in 4 bytes.
+     */
+    static const int MAX_YEAR = 6052;
+
+    /**
+     * The number of characters of a calendar day in DD/MM/YYYY format.
+     */
+    static const long CALENDAR_DAY_SIZE = 10;
+
+    /**
+     * The number of characters of a clock time in HH:MM format.
+     */
+    static const long CLOCK_TIME_SIZE = 5;
+
     /**
      * Checks if a year is leap.
      *
@@ -92,6 +127,20 @@ public:
      */
     std::string getCompleteDate() const;
 
+    /**
+     * Gets the number of minutes since the 1st of January of 1970.
+     *
+     * @return the number of minutes
+     */
+    std::int32_t getMinutes() const;
+
+    /**
+     * Gets the number of whole days since the 1st of January of 1970.
+     *
+     * @return the number of days
+     */
+    std::int32_t getDays() const;
+
     /**
      * Adds days to the date.
      *
@@ -107,7 +156,7 @@ public:
     void addMinutes(int minutes);
 
     /**
-     * One date is equal to other when their complete dates are equal.
+     * One date is equal to other when they correspond to the same minute.
      *
      * @param d2 the date to compare with
      * @return true, if the dates are equal; false, otherwise
@@ -123,16 +172,85 @@ public:
     bool operator<(const Date& d2) const;
 private:
     /**
-     * Checks if the date is valid.
+     * A date of the civil (proleptic Gregorian) calendar.
+     */
+    struct CivilDay {
+        int year;
+        unsigned month;
+        unsigned day;
+    };
+
+    /**
+     * Gets the number of days since the 1st of January of 1970 of a civil date.
+     *
+     * @param year the year
+     * @param month the month
+     * @param day the day
+     * @return the number of days
+     */
+    static constexpr std::int32_t daysFromCivil(int year, unsigned month, unsigned day) {
+        // years start on March, so that the leap day is the last one of the year
+        year -= month <= 2;
+        const int era = (year >= 0 ? year : year - 399) / 400;
+        const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+        const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + static_cast<std::int32_t>(dayOfEra) - 719468;
+    }
+
+    /**
+     * Gets the civil date of a number of days since the 1st of January of 1970.
+     *
+     * @param days the number of days
+     * @return the civil date
+     */
+    static constexpr CivilDay civilFromDays(std::int32_t days) {
+        days += 719468;
+        const int era = (days >= 0 ? days : days - 146096) / 146097;
+        const unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+        const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const unsigned shiftedMonth = (5 * dayOfYear + 2) / 153;
+        const unsigned month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+        return CivilDay{static_cast<int>(yearOfEra) + era * 400 + (month <= 2), month,
+                        dayOfYear - (153 * shiftedMonth + 2) / 5 + 1};
+    }
+
+    /**
+     * Checks if the calendar fields make a valid date.
+     *
+     * @param day the day
+     * @param month the month
+     * @param year the year
+     * @param hour the hour
+     * @param minute the minute
+     * @return true, if it is a valid date whose year is from MIN_YEAR to MAX_YEAR; false, otherwise
+     */
+    static bool isValid(int day, int month, int year, int hour, int minute);
+
+    /**
+     * Formats the calendar fields in DD/MM/YYYY HH:MM format.
+     *
+     * @param day the day
+     * @param month the month
+     * @param year the year
+     * @param hour the hour
+     * @param minute the minute
+     * @param str the 16 characters where the date is formatted
+     */
+    static void format(int day, int month, int year, int hour, int minute, char* str);
+
+    /**
+     * Gets the civil date of the date.
      *
-     * @return true, if it is a valid date; false, otherwise
+     * @return the civil date
      */
-    bool isValid() const;
+    CivilDay getCivilDay() const;
 
     /**
-     * Struct to get the current calendar date and time.
+     * The number of minutes since the 1st of January of 1970.
      */
-    tm _time;
+    std::int32_t _minutes;
 };
 
 #endif //FEUP_AEDA_PROJECT_DATE_H
@@ -5,10 +5,14 @@
 
 const char* Order::DEFAULT_LOCATION = "Head Office";
 
-Order::Order(Client &client, Worker &worker, std::string location, Date date) :
-        _client(&client), _worker(&worker), _clientEvaluation(0), _delivered(false),
-        _totalPrice(0.0f), _requestDate(date), _deliverDate(date), _products(),
-        _deliverLocation(std::move(location)){
+Order::Order(Client &client, Worker &worker, Location location, Date date) :
+        _id(0), _client(&client), _worker(&worker), _clientEvaluation(0), _delivered(false),
+        _totalPrice(0.0f), _finalPrice(0.0f), _requestDate(date), _deliverDate(date), _products(),
+        _deliverLocation(location){
+}
+
+Order::Order(Client &client, Worker &worker, const std::string &location, Date date) :
+        Order(client, worker, Location(location), date){
 }
 
 bool Order::hasDiscount() const {
@@ -25,6 +29,14 @@ bool Order::wasDelivered() const {
     return _delivered;
 }
 
+unsigned long Order::getId() const {
+    return _id;
+}
+
+OrderPriority Order::getPriority() const {
+    return {_delivered, _client->getMeanEvaluation(), _client->getNumDiscounts()};
+}
+
 Worker* Order::getWorker() const {
     return _worker;
 }
@@ -33,7 +45,7 @@ Client* Order::getClient() const {
     return _client;
 }
 
-std::map<Product *, unsigned int, ProductSmaller> Order::getProducts() const {
+const OrderProducts& Order::getProducts() const {
     return _products;
 }
 
@@ -43,6 +55,7 @@ int Order::getClientEvaluation() const {
 }
 
 float Order::getFinalPrice() const {
+    if (_delivered) return _finalPrice;
     return hasDiscount() ? (_client->isPremium() ? 0.95f*_totalPrice : 0.98f*_totalPrice) : _totalPrice;
 }
 
@@ -54,31 +67,33 @@ Date Order::getRequestDate() const {
     return _requestDate;
 }
 
-void Order::updateTotalPrice() {
-    _totalPrice = 0.0f;
-    for(const auto &product : _products){
-        _totalPrice += (product.first->getPrice() * product.second);
-    }
+void Order::updateTotalPrice(const Product* product, long quantityDelta) {
+    if (_products.empty()) _totalPrice = 0.0f; // no rounding leftovers
+    else _totalPrice += product->getPrice() * static_cast<float>(quantityDelta);
 }
 
 Product * Order::addProduct(Product* product, unsigned quantity) {
     if (quantity == 0) throw std::invalid_argument("Quantity cannot be 0!");
     if (_delivered) throw OrderWasAlreadyDelivered(*_client, *_worker, _requestDate);
 
-    if (hasProduct(product)) _products[product] += quantity;
+    auto it = _products.find(product);
+    if (it != _products.end()) it->second += quantity;
     else{
-        _products[product] = quantity;
+        _products.insert(product, quantity);
         product->addInclusion();
     }
-    updateTotalPrice();
+    updateTotalPrice(product, quantity);
     return product;
 }
 
 void Order::removeProduct(Product *product) {
     if (_delivered) throw OrderWasAlreadyDelivered(*_client, *_worker, _requestDate);
-    if (hasProduct(product)){
-        _products.erase(product);
-        updateTotalPrice();
+    auto it = _products.find(product);
+    if (it != _products.end()){
+        Product* included = it->first;
+        unsigned quantity = it->second;
+        _products.erase(it);
+        updateTotalPrice(included, -static_cast<long>(quantity));
         product->removeInclusion();
     }
     else throw ProductDoesNotExist(product->getName(),product->getPrice());
@@ -86,12 +101,13 @@ void Order::removeProduct(Product *product) {
 
 void Order::removeProduct(unsigned long position) {
     if (_delivered) throw OrderWasAlreadyDelivered(*_client, *_worker, _requestDate);
-    auto it = _products.begin();
     if (position < _products.size()){
-        std::advance(it,position);
+        auto it = _products.begin() + position;
+        Product* product = it->first;
+        unsigned quantity = it->second;
         _products.erase(it);
-        updateTotalPrice();
-        it->first->removeInclusion();
+        updateTotalPrice(product, -static_cast<long>(quantity));
+        product->removeInclusion();
     }
     else throw InvalidProductPosition(position, _products.size());
 }
@@ -101,12 +117,13 @@ void Order::deliver(int clientEvaluation, bool updatePoints, int deliverDuration
     if (clientEvaluation < 0 || clientEvaluation > 5) throw InvalidOrderEvaluation(clientEvaluation,*_client);
 
     _clientEvaluation = clientEvaluation;
+    _finalPrice = getFinalPrice(); // the price the client pays, before the points are reset
     _delivered = true;
-    _worker->addEvaluation(clientEvaluation);
     _client->addEvaluation(clientEvaluation);
 
     if (deliverDuration != 0) _deliverDate.addMinutes(deliverDuration);
     else _deliverDate = Date();
+    _worker->addDelivery(static_cast<unsigned>(clientEvaluation), _finalPrice, _deliverDate);
 
     if (hasDiscount()) _client->addDiscount();
 
@@ -118,17 +135,11 @@ void Order::deliver(int clientEvaluation, bool updatePoints, int deliverDuration
 
 bool Order::operator==(const Order &rhs) const {
     return *_client == *rhs.getClient() && *_worker == *rhs.getWorker()
-    && _deliverLocation == rhs.getDeliverLocation() && _requestDate == rhs.getRequestDate();
+    && _deliverLocation == rhs._deliverLocation && _requestDate == rhs.getRequestDate();
 }
 
 bool Order::operator<(const Order &o2) const {
-    if (wasDelivered() != o2.wasDelivered()){
-        return wasDelivered();
-    }
-    if (_client->getMeanEvaluation() != o2._client->getMeanEvaluation()){
-        return _client->getMeanEvaluation() > o2._client->getMeanEvaluation();
-    }
-    return _client->getNumDiscounts() > o2._client->getNumDiscounts();
+    return getPriority() < o2.getPriority();
 }
 
 void Order::print(std::ostream &os) const {
@@ -157,7 +168,7 @@ void Order::print(std::ostream &os) const {
            << util::column("Unit price")
            << util::column("Quantity") << "\n";
         int count = 1;
-        for (const auto &p: getProducts()) {
+        for (const auto &p: _products) {
             os << std::to_string(count++) + ". ";
             p.first->print(os);
             os << util::column(std::to_string(p.second)) << std::endl;
@@ -175,11 +186,15 @@ Date Order::getDeliverDate() const {
     return _deliverDate;
 }
 
-std::string Order::getDeliverLocation() const {
+const std::string& Order::getDeliverLocation() const {
+    return _deliverLocation;
+}
+
+const Location& Order::getDeliverLocationHandle() const {
     return _deliverLocation;
 }
 
-void Order::setDeliverLocation(const std::string& location, Worker* newWorker) {
+void Order::setDeliverLocation(const Location& location, Worker* newWorker) {
     if (_delivered) throw OrderWasAlreadyDelivered(*_client,*_worker,_deliverDate);
     _worker = newWorker;
     _deliverLocation = location;
@@ -9,9 +9,49 @@
 #include "model/product/product.h"
 #include "model/product/product_manager.h"
 #include "model/date/date.h"
+#include "model/store/location.h"
+
+#include "util/small_flat_map.h"
 
 #include <fstream>
-#include <map>
+
+/**
+ * The fields which decide the delivery priority of an order.
+ */
+struct OrderPriority {
+    /**
+     * Whether the order was already delivered.
+     */
+    bool delivered;
+
+    /**
+     * The mean evaluation given by the order client.
+     */
+    float clientEvaluation;
+
+    /**
+     * The number of discounts the order client has benefited from.
+     */
+    unsigned clientDiscounts;
+
+    /**
+     * One priority is less than another if the order has already been delivered, if the client feedback is higher,
+     * or the client has benefited from more discounts.
+     *
+     * @param rhs the priority to compare with
+     * @return true, if the priority is less than rhs; false, otherwise
+     */
+    bool operator<(const OrderPriority& rhs) const {
+        if (delivered != rhs.delivered) return delivered;
+        if (clientEvaluation != rhs.clientEvaluation) return clientEvaluation > rhs.clientEvaluation;
+        return clientDiscounts > rhs.clientDiscounts;
+    }
+};
+
+/**
+ * The products of an order with their requested quantities, sorted like the products list.
+ */
+typedef SmallFlatMap<Product*, unsigned, ProductSmaller> OrderProducts;
 
 /**
  * Class relative to a store order.
@@ -26,7 +66,17 @@ public:
      * @param location the store location; defaults to Head Office
      * @param date the request date; defaults to the current date
      */
-    Order(Client& client, Worker& worker, std::string location = DEFAULT_LOCATION, Date date = {});
+    Order(Client& client, Worker& worker, Location location = Location(DEFAULT_LOCATION), Date date = {});
+
+    /**
+     * Creates a new Order object, interning the name of its location.
+     *
+     * @param client the client
+     * @param worker the worker
+     * @param location the name of the store location
+     * @param date the request date; defaults to the current date
+     */
+    Order(Client& client, Worker& worker, const std::string& location, Date date = {});
 
     /**
      * Checks if the order has discount.
@@ -51,6 +101,20 @@ public:
      */
     bool wasDelivered() const;
 
+    /**
+     * Gets the order identifier, assigned by the order manager when the order is added to the orders list.
+     *
+     * @return the order identifier; 0, if the order is not managed
+     */
+    unsigned long getId() const;
+
+    /**
+     * Gets the current order delivery priority.
+     *
+     * @return the order priority
+     */
+    OrderPriority getPriority() const;
+
     /**
      * Gets the order worker.
      *
@@ -70,14 +134,21 @@ public:
      *
      * @return the store location
      */
-    std::string getDeliverLocation() const;
+    const std::string& getDeliverLocation() const;
+
+    /**
+     * Gets the interned store location where the order will be delivered.
+     *
+     * @return the store location
+     */
+    const Location& getDeliverLocationHandle() const;
 
     /**
      * Gets the list of all products with the respective requested quantity.
      *
      * @return map of included products to their quantities
      */
-    std::map<Product*, unsigned int, ProductSmaller> getProducts() const;
+    const OrderProducts& getProducts() const;
 
     /**
      * Gets the evaluation of the order, given by the client when the order is delivered.
@@ -87,7 +158,8 @@ public:
     int getClientEvaluation() const;
 
     /**
-     * Gets the order final price (with the discount in case the client has it).
+     * Gets the order final price (with the discount in case the client has it). Once the order is delivered, the
+     * price it had at the time is kept, even if the client points change afterwards.
      *
      * @return the final price
      */
@@ -153,7 +225,7 @@ private:
     *
     * @param location the store location
     */
-    void setDeliverLocation(const std::string& location, Worker* newWorker);
+    void setDeliverLocation(const Location& location, Worker* newWorker);
 
     /**
     * Delivers the order and gets the client evaluation and deliver duration.
@@ -188,20 +260,33 @@ private:
     void removeProduct(unsigned long position);
 
     /**
-    * Updates total price whenever is added products to the order.
-    */
-    void updateTotalPrice();
+     * Updates the total price whenever the quantity of a product changes.
+     *
+     * @param product the product
+     * @param quantityDelta the change of its quantity
+     */
+    void updateTotalPrice(const Product* product, long quantityDelta);
+
+    /**
+     * The order identifier (0 while the order is not on any orders list).
+     */
+    unsigned long _id;
 
     /**
      * The products list with its relative available quantity.
      */
-    std::map<Product*, unsigned int, ProductSmaller> _products;
+    OrderProducts _products;
 
     /**
      * The order total price (without any discount).
      */
     float _totalPrice;
 
+    /**
+     * The order final price, fixed when the order is delivered.
+     */
+    float _finalPrice;
+
     /**
      * The client who requested the order.
      */
@@ -235,7 +320,7 @@ private:
     /**
      * The store location to deliver the order.
      */
-    std::string _deliverLocation;
+    Location _deliverLocation;
 };
 
 #endif //SRC_ORDER_H
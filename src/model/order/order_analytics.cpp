@@ -0,0 +1,167 @@
+#include "order_analytics.h"
+
+#include "order.h"
+#include "order_archive.h"
+#include "model/product/product_manager.h"
+
+#include <algorithm>
+
+namespace {
+    /**
+     * Gets the date of a day.
+     *
+     * @param day the number of days since the epoch
+     * @return the date, at midnight
+     */
+    Date toDate(std::int32_t day) {
+        Date date(1, 1, 1970);
+        date.addDays(day);
+        return date;
+    }
+
+    /**
+     * Gets the first day of the period a day belongs to.
+     *
+     * @param day the number of days since the epoch
+     * @param bucket the period
+     * @return the first day of the period
+     */
+    std::int32_t getBucketStart(std::int32_t day, TimeBucket bucket) {
+        switch (bucket) {
+            // the epoch was on a Thursday
+            case TimeBucket::WEEK: return day - ((day % 7 + 10) % 7);
+            case TimeBucket::MONTH: {
+                Date date = toDate(day);
+                return Date(1, static_cast<int>(date.getMonth()), static_cast<int>(date.getYear())).getDays();
+            }
+            default: return day;
+        }
+    }
+
+    /**
+     * Gets the first day of the period after the one a day belongs to.
+     *
+     * @param day the number of days since the epoch
+     * @param bucket the period
+     * @return the first day of the next period
+     */
+    std::int32_t getNextBucketStart(std::int32_t day, TimeBucket bucket) {
+        switch (bucket) {
+            case TimeBucket::WEEK: return getBucketStart(day, bucket) + 7;
+            case TimeBucket::MONTH: {
+                Date date = toDate(day);
+                int month = static_cast<int>(date.getMonth()), year = static_cast<int>(date.getYear());
+                return month == 12 ? Date(1, 1, year + 1).getDays() : Date(1, month + 1, year).getDays();
+            }
+            default: return day + 1;
+        }
+    }
+}
+
+OrderAnalytics::OrderAnalytics() : _all(), _byLocation(), _firstDay(0), _empty(true) {
+}
+
+void OrderAnalytics::add(const Order *order) {
+    std::array<float, 2> typeTotals{};
+    for (const auto& product : order->getProducts()){
+        bool bread = dynamic_cast<const Bread*>(product.first) != nullptr;
+        typeTotals[bread ? 0 : 1] += product.first->getPrice() * static_cast<float>(product.second);
+    }
+    add(order->getDeliverLocationHandle(), order->getRequestDate(), order->getFinalPrice(),
+        order->getClientEvaluation(), typeTotals);
+}
+
+void OrderAnalytics::add(const ArchivedOrder &order, ProductManager &productManager) {
+    std::array<float, 2> typeTotals{};
+    for (const auto& product : order.products){
+        const float price = std::get<1>(product);
+        try {
+            bool bread = dynamic_cast<const Bread*>(productManager.get(std::get<0>(product), price)) != nullptr;
+            typeTotals[bread ? 0 : 1] += price * static_cast<float>(std::get<2>(product));
+        }
+        catch (ProductDoesNotExist&) {}
+    }
+    add(Location(order.location), order.requestDate, order.finalPrice, order.clientEvaluation, typeTotals);
+}
+
+AnalyticsTotals OrderAnalytics::get(const Date &from, const Date &to, const Location *location, ProductType type) const {
+    AnalyticsTotals totals = sum(from.getDays(), to.getDays() + 1, location, type);
+    totals.from = toDate(from.getDays());
+    return totals;
+}
+
+std::vector<AnalyticsTotals> OrderAnalytics::getSeries(const Date &from, const Date &to, TimeBucket bucket,
+                                                       const Location *location, ProductType type) const {
+    std::vector<AnalyticsTotals> series;
+    const std::int32_t last = to.getDays();
+    for (std::int32_t day = from.getDays(); day <= last; day = getNextBucketStart(day, bucket)){
+        const std::int32_t end = std::min(getNextBucketStart(day, bucket), last + 1);
+        series.push_back(sum(day, end, location, type));
+        series.back().from = toDate(day);
+    }
+    return series;
+}
+
+void OrderAnalytics::add(const Location &location, const Date &requestDate, float finalPrice, int evaluation,
+                         const std::array<float, 2>& typeTotals) {
+    const std::size_t index = getIndex(requestDate.getDays());
+    const float total = typeTotals[0] + typeTotals[1];
+
+    for (TypeColumns* columns : {&_all, &_byLocation[location]}){
+        for (std::size_t type = 0; type < columns->size(); ++type){
+            double revenue = finalPrice;
+            if (type != static_cast<std::size_t>(ProductType::ANY_PRODUCT)){
+                if (typeTotals[type] <= 0) continue;
+                revenue = static_cast<double>(finalPrice) * typeTotals[type] / total;
+            }
+            Columns& typeColumns = (*columns)[type];
+            typeColumns.revenue.add(index, revenue);
+            typeColumns.orders.add(index, 1);
+            typeColumns.evaluationsSum.add(index, static_cast<unsigned long>(evaluation));
+        }
+    }
+}
+
+void OrderAnalytics::shift(TypeColumns &columns, std::size_t count) {
+    for (auto& typeColumns : columns){
+        typeColumns.revenue.shift(count);
+        typeColumns.orders.shift(count);
+        typeColumns.evaluationsSum.shift(count);
+    }
+}
+
+std::size_t OrderAnalytics::getIndex(std::int32_t day) {
+    if (_empty){
+        _firstDay = day;
+        _empty = false;
+    }
+    else if (day < _firstDay){
+        // every column must start on the same day; move them by at least a year, so that this is seldom done
+        const std::size_t count = std::max<std::size_t>(static_cast<std::size_t>(_firstDay - day), 366);
+        shift(_all, count);
+        for (auto& location : _byLocation) shift(location.second, count);
+        _firstDay -= static_cast<std::int32_t>(count);
+    }
+    return static_cast<std::size_t>(day - _firstDay);
+}
+
+AnalyticsTotals OrderAnalytics::sum(std::int32_t from, std::int32_t to, const Location *location, ProductType type) const {
+    AnalyticsTotals totals{Date(1, 1, 1970), 0.0f, 0, 0};
+    if (_empty) return totals;
+
+    const TypeColumns* columns = &_all;
+    if (location){
+        auto it = _byLocation.find(*location);
+        if (it == _byLocation.end()) return totals;
+        columns = &it->second;
+    }
+
+    // days before the first one have no orders
+    const std::size_t begin = from > _firstDay ? static_cast<std::size_t>(from - _firstDay) : 0;
+    const std::size_t end = to > _firstDay ? static_cast<std::size_t>(to - _firstDay) : 0;
+    const Columns& typeColumns = (*columns)[static_cast<std::size_t>(type)];
+    totals.revenue = static_cast<float>(typeColumns.revenue.sum(begin, end));
+    totals.orders = typeColumns.orders.sum(begin, end);
+    totals.evaluationsSum = typeColumns.evaluationsSum.sum(begin, end);
+    return totals;
+}
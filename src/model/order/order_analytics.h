@@ -0,0 +1,196 @@
+#ifndef FEUP_AEDA_PROJECT_ORDER_ANALYTICS_H
+#define FEUP_AEDA_PROJECT_ORDER_ANALYTICS_H
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "model/date/date.h"
+#include "model/store/location.h"
+#include "util/fenwick_tree.h"
+
+class Order;
+struct ArchivedOrder;
+class ProductManager;
+
+/**
+ * The product types the analytics are sliced by. ANY_PRODUCT counts each order once, whatever it holds.
+ */
+enum class ProductType {
+    BREAD, CAKE, ANY_PRODUCT
+};
+
+/**
+ * The calendar periods the analytics can be grouped by. Weeks start on Monday.
+ */
+enum class TimeBucket {
+    DAY, WEEK, MONTH
+};
+
+/**
+ * The totals of the delivered orders of a slice of the analytics.
+ */
+struct AnalyticsTotals {
+    /**
+     * The first day of the period the totals refer to.
+     */
+    Date from;
+
+    /**
+     * The revenue of the orders. When slicing by product type, the final price of each order is split by the share of
+     * that type on its total.
+     */
+    float revenue;
+
+    /**
+     * The number of orders (which hold the product type, when slicing by it).
+     */
+    unsigned long orders;
+
+    /**
+     * The sum of the client evaluations of the orders.
+     */
+    unsigned long evaluationsSum;
+
+    /**
+     * Gets the mean client evaluation of the orders.
+     *
+     * @return the mean evaluation; 0, if there are no orders
+     */
+    float getMeanEvaluation() const {
+        return orders ? static_cast<float>(evaluationsSum) / static_cast<float>(orders) : 0.0f;
+    }
+};
+
+/**
+ * Class relative to the analytics of the delivered orders: revenue, number of orders and evaluations by delivery
+ * location, request day and product type. Each metric is kept as its own column of daily values, under prefix sums,
+ * so that the totals of any range of days are found without going through the orders.
+ */
+class OrderAnalytics {
+public:
+    /**
+     * Creates a new empty OrderAnalytics object.
+     */
+    OrderAnalytics();
+
+    /**
+     * Adds a delivered order, on the day it was requested.
+     *
+     * @param order the order
+     */
+    void add(const Order* order);
+
+    /**
+     * Adds an order read back from the archive, on the day it was requested. The type of each product is found on the
+     * products list; products which are no longer there are only counted as ANY_PRODUCT.
+     *
+     * @param order the archived order
+     * @param productManager the products list
+     */
+    void add(const ArchivedOrder& order, ProductManager& productManager);
+
+    /**
+     * Gets the totals of a range of days.
+     *
+     * @param from the first day
+     * @param to the last day (inclusive)
+     * @param location the delivery location; nullptr, for all locations
+     * @param type the product type
+     * @return the totals
+     */
+    AnalyticsTotals get(const Date& from, const Date& to, const Location* location = nullptr,
+                        ProductType type = ProductType::ANY_PRODUCT) const;
+
+    /**
+     * Gets the totals of each day, week or month of a range of days. The first and the last periods are cut to the
+     * range.
+     *
+     * @param from the first day
+     * @param to the last day (inclusive)
+     * @param bucket the period to group by
+     * @param location the delivery location; nullptr, for all locations
+     * @param type the product type
+     * @return the totals of each period, from the oldest to the newest
+     */
+    std::vector<AnalyticsTotals> getSeries(const Date& from, const Date& to, TimeBucket bucket,
+                                           const Location* location = nullptr,
+                                           ProductType type = ProductType::ANY_PRODUCT) const;
+
+private:
+    /**
+     * The daily values of each metric of a slice.
+     */
+    struct Columns {
+        FenwickTree<double> revenue;
+        FenwickTree<unsigned long> orders;
+        FenwickTree<unsigned long> evaluationsSum;
+    };
+
+    /**
+     * The columns of each product type.
+     */
+    typedef std::array<Columns, 3> TypeColumns;
+
+    /**
+     * Adds an order to the columns of its location and to the columns of all locations.
+     *
+     * @param location the delivery location
+     * @param requestDate the request date
+     * @param finalPrice the final price
+     * @param evaluation the client evaluation
+     * @param typeTotals the total price of the products of each type (bread and cake)
+     */
+    void add(const Location& location, const Date& requestDate, float finalPrice, int evaluation,
+             const std::array<float, 2>& typeTotals);
+
+    /**
+     * Inserts days with no orders before the first day of every column of a slice.
+     *
+     * @param columns the columns of each product type
+     * @param count the number of days
+     */
+    static void shift(TypeColumns& columns, std::size_t count);
+
+    /**
+     * Gets the index of the daily values of a day, moving every column forward if the day is before the first one.
+     *
+     * @param day the number of days since the epoch
+     * @return the index
+     */
+    std::size_t getIndex(std::int32_t day);
+
+    /**
+     * Gets the totals of a range of days from a slice.
+     *
+     * @param from the first day
+     * @param to the day after the last one
+     * @param location the delivery location; nullptr, for all locations
+     * @param type the product type
+     * @return the totals
+     */
+    AnalyticsTotals sum(std::int32_t from, std::int32_t to, const Location* location, ProductType type) const;
+
+    /**
+     * The columns of all locations.
+     */
+    TypeColumns _all;
+
+    /**
+     * The columns of each location.
+     */
+    std::unordered_map<Location, TypeColumns, LocationHash> _byLocation;
+
+    /**
+     * The day of the first daily values (number of days since the epoch).
+     */
+    std::int32_t _firstDay;
+
+    /**
+     * Whether any order was added, so that the first day is set.
+     */
+    bool _empty;
+};
+
+#endif //FEUP_AEDA_PROJECT_ORDER_ANALYTICS_H
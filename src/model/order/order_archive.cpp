@@ -0,0 +1,157 @@
+#include "order_archive.h"
+
+#include <fstream>
+
+#include "order.h"
+#include "exception/file_exception.h"
+#include "util/binary_file.h"
+
+const char* OrderArchive::SEGMENT_MAGIC = "BKAR";
+const std::uint32_t OrderArchive::SEGMENT_VERSION = 1;
+
+namespace {
+    void writeDate(BinaryWriter& writer, const Date& date) {
+        writer.writeUInt16(static_cast<std::uint16_t>(date.getYear()));
+        writer.writeUInt8(static_cast<std::uint8_t>(date.getMonth()));
+        writer.writeUInt8(static_cast<std::uint8_t>(date.getDay()));
+        writer.writeUInt8(static_cast<std::uint8_t>(date.getHour()));
+        writer.writeUInt8(static_cast<std::uint8_t>(date.getMinute()));
+    }
+
+    Date readDate(BinaryReader& reader) {
+        int year = reader.readUInt16();
+        int month = reader.readUInt8(), day = reader.readUInt8(), hour = reader.readUInt8(), minute = reader.readUInt8();
+        return Date(day, month, year, hour, minute);
+    }
+
+    bool matches(const Person* person, unsigned long taxID, const std::string& name) {
+        if (!person) return true;
+        return person->getTaxId() == taxID && (taxID != Person::DEFAULT_TAX_ID || person->getName() == name);
+    }
+}
+
+OrderArchive::OrderArchive() : _path(), _segments(), _size(0), _profit(0), _evaluationsSum(0) {
+}
+
+void OrderArchive::open(const std::string &path) {
+    _path = path;
+    _segments.clear();
+    _size = 0; _profit = 0; _evaluationsSum = 0;
+
+    for (std::size_t number = 0; std::ifstream(getSegmentPath(number)); ++number){
+        BinaryReader file(getSegmentPath(number), SEGMENT_MAGIC, SEGMENT_VERSION);
+        Segment segment = readSummary(file);
+        include(std::move(segment));
+    }
+}
+
+bool OrderArchive::isOpen() const {
+    return !_path.empty();
+}
+
+void OrderArchive::add(const std::vector<const Order *> &orders) {
+    Segment segment{getSegmentPath(_segments.size()), orders.size(), 0, 0, {}, {}};
+    BinaryWriter records;
+    for (const auto& order : orders){
+        segment.profit += order->getFinalPrice();
+        segment.evaluationsSum += static_cast<unsigned long>(order->getClientEvaluation());
+        segment.clients.insert(order->getClient()->getTaxId());
+        segment.workers.insert(order->getWorker()->getTaxId());
+
+        records.writeUInt64(order->getClient()->getTaxId());
+        records.writeString(order->getClient()->getName());
+        records.writeUInt64(order->getWorker()->getTaxId());
+        records.writeString(order->getWorker()->getName());
+        records.writeString(order->getDeliverLocation());
+        writeDate(records, order->getRequestDate());
+        writeDate(records, order->getDeliverDate());
+        records.writeUInt8(static_cast<std::uint8_t>(order->getClientEvaluation()));
+        records.writeFloat(order->getFinalPrice());
+
+        const OrderProducts& products = order->getProducts();
+        records.writeUInt32(static_cast<std::uint32_t>(products.size()));
+        for (const auto& product : products){
+            records.writeString(product.first->getName());
+            records.writeFloat(product.first->getPrice());
+            records.writeUInt32(product.second);
+        }
+    }
+
+    BinaryWriter file;
+    file.writeUInt32(static_cast<std::uint32_t>(segment.size));
+    file.writeFloat(segment.profit);
+    file.writeUInt64(segment.evaluationsSum);
+    for (const auto* people : {&segment.clients, &segment.workers}){
+        file.writeUInt32(static_cast<std::uint32_t>(people->size()));
+        for (const auto& taxID : *people) file.writeUInt64(taxID);
+    }
+    file.append(records);
+    file.save(segment.path, SEGMENT_MAGIC, SEGMENT_VERSION);
+
+    include(std::move(segment));
+}
+
+std::vector<ArchivedOrder> OrderArchive::get(const Person *client, const Person *worker) const {
+    std::vector<ArchivedOrder> orders;
+    for (const auto& segment : _segments){
+        if (client && !segment.clients.count(client->getTaxId())) continue;
+        if (worker && !segment.workers.count(worker->getTaxId())) continue;
+
+        BinaryReader file(segment.path, SEGMENT_MAGIC, SEGMENT_VERSION);
+        readSummary(file);
+        for (unsigned long i = 0; i < segment.size; ++i){
+            ArchivedOrder order;
+            order.clientTaxID = file.readUInt64();
+            order.clientName = file.readString();
+            order.workerTaxID = file.readUInt64();
+            order.workerName = file.readString();
+            order.location = file.readString();
+            order.requestDate = readDate(file);
+            order.deliverDate = readDate(file);
+            order.clientEvaluation = file.readUInt8();
+            order.finalPrice = file.readFloat();
+            for (std::uint32_t products = file.readUInt32(); products; --products){
+                std::string name = file.readString();
+                float price = file.readFloat();
+                order.products.emplace_back(std::move(name), price, file.readUInt32());
+            }
+
+            if (matches(client, order.clientTaxID, order.clientName) && matches(worker, order.workerTaxID, order.workerName))
+                orders.push_back(std::move(order));
+        }
+    }
+    return orders;
+}
+
+unsigned long OrderArchive::getSize() const {
+    return _size;
+}
+
+float OrderArchive::getProfit() const {
+    return _profit;
+}
+
+unsigned long OrderArchive::getEvaluationsSum() const {
+    return _evaluationsSum;
+}
+
+std::string OrderArchive::getSegmentPath(std::size_t number) const {
+    return _path + "." + std::to_string(number);
+}
+
+OrderArchive::Segment OrderArchive::readSummary(BinaryReader &file) {
+    Segment segment{file.getPath(), 0, 0, 0, {}, {}};
+    segment.size = file.readUInt32();
+    segment.profit = file.readFloat();
+    segment.evaluationsSum = file.readUInt64();
+    for (auto* people : {&segment.clients, &segment.workers})
+        for (std::uint32_t count = file.readUInt32(); count; --count) people->insert(file.readUInt64());
+    return segment;
+}
+
+void OrderArchive::include(Segment segment) {
+    _size += segment.size;
+    _profit += segment.profit;
+    _evaluationsSum += segment.evaluationsSum;
+    _segments.push_back(std::move(segment));
+}
@@ -0,0 +1,180 @@
+#ifndef FEUP_AEDA_PROJECT_ORDER_ARCHIVE_H
+#define FEUP_AEDA_PROJECT_ORDER_ARCHIVE_H
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include "model/date/date.h"
+
+class Order;
+class Person;
+class BinaryWriter;
+class BinaryReader;
+
+/**
+ * A delivered order as it was saved on the archive. People, products and locations are kept by value, since they may
+ * have been removed from the store in the meantime.
+ */
+struct ArchivedOrder {
+    std::string clientName;
+    unsigned long clientTaxID;
+    std::string workerName;
+    unsigned long workerTaxID;
+    std::string location;
+    Date requestDate;
+    Date deliverDate;
+    int clientEvaluation;
+    float finalPrice;
+
+    /**
+     * The name, price and quantity of each product.
+     */
+    std::vector<std::tuple<std::string, float, unsigned>> products;
+};
+
+/**
+ * Class relative to the on-disk archive of delivered orders. The archive is a sequence of segment files, each one
+ * written at once; only a summary of each segment (its totals and who it holds orders of) is kept in memory, and the
+ * orders are read back from the disk when they are asked for.
+ */
+class OrderArchive {
+public:
+    /**
+     * Creates a new closed OrderArchive object.
+     */
+    OrderArchive();
+
+    /**
+     * Opens the archive, loading the summary of the segments which were already saved.
+     *
+     * @param path the archive path; the segments are saved on this path, followed by their number
+     * @throws InvalidFile if a segment is corrupted
+     */
+    void open(const std::string& path);
+
+    /**
+     * Checks if the archive was opened.
+     *
+     * @return true, if the archive was opened; false, otherwise
+     */
+    bool isOpen() const;
+
+    /**
+     * Saves a list of delivered orders on a new segment.
+     *
+     * @param orders the orders
+     * @throws FileNotFound if the segment can't be written
+     */
+    void add(const std::vector<const Order*>& orders);
+
+    /**
+     * Reads the archived orders of a certain client, or of a certain worker. If neither is provided, all archived
+     * orders are read. Only the segments which hold orders of that person are loaded.
+     *
+     * @param client the client
+     * @param worker the worker
+     * @return the list of archived orders, from the oldest to the newest segment
+     * @throws InvalidFile if a segment is corrupted
+     */
+    std::vector<ArchivedOrder> get(const Person* client = nullptr, const Person* worker = nullptr) const;
+
+    /**
+     * Gets the number of archived orders.
+     *
+     * @return the number of orders
+     */
+    unsigned long getSize() const;
+
+    /**
+     * Gets the sum of the final prices of the archived orders.
+     *
+     * @return the profit
+     */
+    float getProfit() const;
+
+    /**
+     * Gets the sum of the evaluations given to the archived orders.
+     *
+     * @return the sum of the evaluations
+     */
+    unsigned long getEvaluationsSum() const;
+
+    /**
+     * The 4 characters which identify a segment file.
+     */
+    static const char* SEGMENT_MAGIC;
+
+    /**
+     * The current version of the segment format.
+     */
+    static const std::uint32_t SEGMENT_VERSION;
+
+private:
+    /**
+     * The summary of a segment.
+     */
+    struct Segment {
+        std::string path;
+        unsigned long size;
+        float profit;
+        unsigned long evaluationsSum;
+
+        /**
+         * The taxpayer identification numbers of the clients and workers of the orders on the segment.
+         */
+        std::unordered_set<unsigned long> clients, workers;
+    };
+
+    /**
+     * Gets the path of a segment.
+     *
+     * @param number the number of the segment
+     * @return the path
+     */
+    std::string getSegmentPath(std::size_t number) const;
+
+    /**
+     * Reads the summary at the beginning of a segment.
+     *
+     * @param file the segment file
+     * @return the summary
+     */
+    static Segment readSummary(BinaryReader& file);
+
+    /**
+     * Adds the totals of a segment to the totals of the archive.
+     *
+     * @param segment the segment
+     */
+    void include(Segment segment);
+
+    /**
+     * The archive path.
+     */
+    std::string _path;
+
+    /**
+     * The summary of each segment, from the oldest to the newest.
+     */
+    std::vector<Segment> _segments;
+
+    /**
+     * The number of archived orders.
+     */
+    unsigned long _size;
+
+    /**
+     * The sum of the final prices of the archived orders.
+     */
+    float _profit;
+
+    /**
+     * The sum of the evaluations given to the archived orders.
+     */
+    unsigned long _evaluationsSum;
+};
+
+#endif //FEUP_AEDA_PROJECT_ORDER_ARCHIVE_H
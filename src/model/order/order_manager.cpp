@@ -1,108 +1,121 @@
 
 #include "order_manager.h"
 #include "exception/file_exception.h"
+#include "util/file_reader.h"
+#include "util/file_writer.h"
+#include "util/util.h"
+
+#include <map>
+#include <tuple>
+#include <unordered_set>
+
+const OrderQueue OrderManager::EMPTY_QUEUE;
+const DeliverySketches OrderManager::EMPTY_SKETCHES;
 
 OrderManager::OrderManager(ProductManager* pm, ClientManager* cm, WorkerManager* wm, LocationManager* lm) :
-        _productManager(pm), _clientManager(cm), _workerManager(wm), _locationManager(lm), _orders{}{
+        _productManager(pm), _clientManager(cm), _workerManager(wm), _locationManager(lm), _orders{}, _archive(),
+        _analytics(), _sketchesHoldArchive(false), _ordersById{}, _lastOrderId(0), _deliveredCount(0), _evaluationsSum(0), _revenue(0), _journal(nullptr){
 }
 
 bool OrderManager::has(Order *order) const {
-    std::priority_queue<OrderEntry> tmpOrders = _orders;
-    for (; !tmpOrders.empty(); tmpOrders.pop()){
-        const auto& o = tmpOrders.top().getOrder();
-        if (*o == *order) return true;
-    }
-    return false;
+    return find(order) != _orders.end();
 }
 
 Order* OrderManager::get(unsigned long position, Client* client, Worker* worker) const {
-    std::priority_queue<OrderEntry> filtered;
     if (client != nullptr && worker != nullptr) throw std::invalid_argument("Can't choose both worker and client");
-    else if (client != nullptr) filtered = get(client);
-    else if (worker != nullptr) filtered = get(worker);
-    else filtered = getAll();
-
-    for (unsigned long counter = 0; !filtered.empty(); filtered.pop()) {
-        const auto& order = filtered.top().getOrder();
-        if(counter++ == position) return order;
-    }
-    throw InvalidOrderPosition(position, filtered.size());
+    if (client != nullptr && !_clientManager->has(client))
+        throw PersonDoesNotExist(client->getName(), client->getTaxId());
+    if (worker != nullptr && !_workerManager->has(worker))
+        throw PersonDoesNotExist(worker->getName(), worker->getTaxId());
+
+    const OrderQueue& orders = client != nullptr ? getOrders(client) :
+            worker != nullptr ? getOrders(worker) : _orders;
+    if (position >= orders.size()) throw InvalidOrderPosition(position, orders.size());
+    auto it = orders.begin();
+    std::advance(it, position);
+    return it->getOrder();
 }
 
 std::priority_queue<OrderEntry> OrderManager::getAll() const {
+    return std::priority_queue<OrderEntry>(_orders.begin(), _orders.end());
+}
+
+const OrderQueue& OrderManager::getOrders() const {
     return _orders;
 }
 
+const OrderQueue& OrderManager::getOrders(const Client *client) const {
+    auto indexed = _ordersByClient.find(client);
+    return indexed != _ordersByClient.end() ? indexed->second : EMPTY_QUEUE;
+}
+
+const OrderQueue& OrderManager::getOrders(const Worker *worker) const {
+    auto indexed = _ordersByWorker.find(worker);
+    return indexed != _ordersByWorker.end() ? indexed->second : EMPTY_QUEUE;
+}
+
+const OrderQueue& OrderManager::getOrders(const Location &location) const {
+    auto indexed = _ordersByLocation.find(location);
+    return indexed != _ordersByLocation.end() ? indexed->second : EMPTY_QUEUE;
+}
+
 std::priority_queue<OrderEntry> OrderManager::get(Client *client) const {
     if (!_clientManager->has(client)) throw PersonDoesNotExist(client->getName(), client->getTaxId());
-    std::priority_queue<OrderEntry> filtered, tmpOrders = _orders;
-    for (; !tmpOrders.empty(); tmpOrders.pop()){
-        const auto& orderEntry = tmpOrders.top();
-        if(*orderEntry.getOrder()->getClient() == *client) filtered.push(orderEntry);
-    }
-    return filtered;
+    const OrderQueue& orders = getOrders(client);
+    return std::priority_queue<OrderEntry>(orders.begin(), orders.end());
 }
 
 std::priority_queue<OrderEntry> OrderManager::get(Worker *worker) const {
     if (!_workerManager->has(worker)) throw PersonDoesNotExist(worker->getName(), worker->getTaxId());
-    std::priority_queue<OrderEntry> filtered, orders = _orders;
-    for(; !orders.empty(); orders.pop()){
-        const auto& orderEntry = orders.top();
-        if(*orderEntry.getOrder()->getWorker() == *worker) filtered.push(orderEntry);
-    }
-    return filtered;
+    const OrderQueue& orders = getOrders(worker);
+    return std::priority_queue<OrderEntry>(orders.begin(), orders.end());
 }
 
 Order* OrderManager::add(Client *client, const std::string& location, const Date &date) {
     if (!_clientManager->has(client)) throw PersonDoesNotExist(client->getName(), client->getTaxId());
     if (!_locationManager->has(location)) throw LocationDoesNotExist(location);
-    auto orderEntry = OrderEntry(new Order(*client,*_workerManager->getLessBusyWorker(location),location,date));
-    orderEntry.getOrder()->getWorker()->addOrderToDeliver();
-    _orders.push(orderEntry);
-    return orderEntry.getOrder();
+    const Location interned(location);
+    auto order = new Order(*client,*_workerManager->getLessBusyWorker(interned),interned,date);
+    _workerManager->addOrderToDeliver(order->getWorker());
+    insert(order);
+    journal(JournalOperation::ORDER_ADDED, order);
+    return order;
 }
 
 Order* OrderManager::add(Client* client, Worker* worker, const std::string& location, const Date& date){
     if (!_clientManager->has(client)) throw PersonDoesNotExist(client->getName(), client->getTaxId());
     if (!_workerManager->has(worker)) throw PersonDoesNotExist(worker->getName(), worker->getTaxId());
     if (!_locationManager->has(location)) throw LocationDoesNotExist(location);
-    auto orderEntry = OrderEntry(new Order(*client, *worker, location, date));
-    orderEntry.getOrder()->getWorker()->addOrderToDeliver();
-    _orders.push(orderEntry);
-    return orderEntry.getOrder();
+    auto order = new Order(*client, *worker, Location(location), date);
+    _workerManager->addOrderToDeliver(order->getWorker());
+    insert(order);
+    journal(JournalOperation::ORDER_ADDED, order);
+    return order;
 }
 
 void OrderManager::remove(Order *order, bool updateWorkerOrders, bool destroy) {
     if(order->wasDelivered()) throw OrderWasAlreadyDelivered(*order->getClient(),*order->getWorker(),order->getRequestDate());
 
-    bool found = false;
-    std::priority_queue<OrderEntry> newQueue;
-    for(; !_orders.empty(); _orders.pop()){
-       const auto orderEntry = _orders.top();
-        if(!found && *orderEntry.getOrder() == *order){
-            found = true;
-            if (updateWorkerOrders) orderEntry.getOrder()->getWorker()->removeOrderToDeliver();
-            if (destroy) delete orderEntry.getOrder();
-        }
-        else newQueue.push(orderEntry);
-    }
-    _orders = newQueue;
-    if (!found) throw OrderDoesNotExist();
+    auto position = find(order);
+    if (position == _orders.end()) throw OrderDoesNotExist();
+    Order* toRemove = position->getOrder();
+    journal(JournalOperation::ORDER_REMOVED, toRemove);
+    erase(position);
+    if (updateWorkerOrders) _workerManager->removeOrderToDeliver(toRemove->getWorker());
+    if (destroy) delete toRemove;
 }
 
 void OrderManager::remove(unsigned long position, bool updateWorkerOrders, bool destroy) {
     if (position >= _orders.size()) throw OrderDoesNotExist();
-    OrderEntry orderToRemove;
-    std::priority_queue<OrderEntry> newQueue;
-
-    for(unsigned long counter = 0; !_orders.empty(); _orders.pop()){
-        const auto& orderEntry = _orders.top();
-        if (counter++ == position) orderToRemove.setOrder(orderEntry.getOrder());
-        else newQueue.push(orderEntry);
-    }
-    _orders = newQueue;
-    if (updateWorkerOrders) orderToRemove.getOrder()->getWorker()->removeOrderToDeliver();
-    if (destroy) delete orderToRemove.getOrder();
+    auto it = _orders.begin();
+    std::advance(it, position);
+    Order* toRemove = it->getOrder();
+    if (toRemove->wasDelivered())
+        throw OrderWasAlreadyDelivered(*toRemove->getClient(), *toRemove->getWorker(), toRemove->getRequestDate());
+    journal(JournalOperation::ORDER_REMOVED, toRemove);
+    erase(it);
+    if (updateWorkerOrders) _workerManager->removeOrderToDeliver(toRemove->getWorker());
+    if (destroy) delete toRemove;
 }
 
 bool OrderManager::print(std::ostream &os, Client* client, Worker* worker) const {
@@ -111,7 +124,11 @@ bool OrderManager::print(std::ostream &os, Client* client, Worker* worker) const
     else if (worker != nullptr) toPrint = get(worker);
     else toPrint = getAll();
 
-    if (toPrint.empty()) {
+    // archived orders are only read from the disk when there are some
+    std::vector<ArchivedOrder> archived;
+    if (_archive.getSize()) archived = _archive.get(client, worker);
+
+    if (toPrint.empty() && archived.empty()) {
         os << "No orders here yet.\n";
         return false;
     }
@@ -136,13 +153,36 @@ bool OrderManager::print(std::ostream &os, Client* client, Worker* worker) const
         std::to_string(order->getClientEvaluation()) + " points)" : "Not Yet",true)
         << util::column(order->getDeliverLocation()) << "\n";
     }
+
+    if (!archived.empty()) {
+        os << "\nArchived orders:\n";
+        for (const auto& order : archived) {
+            os << std::string(3, util::SPACE);
+            if (client == nullptr) os << util::column(order.clientName,true);
+            if (worker == nullptr) os << util::column(order.workerName,true);
+            os << util::column(order.requestDate.getCompleteDate(), true)
+            << util::column(order.deliverDate.getClockTime() + " (" + std::to_string(order.clientEvaluation) + " points)",true)
+            << util::column(order.location) << "\n";
+        }
+    }
     return true;
 }
 
-void OrderManager::read(const std::string &path) {
-    std::ifstream file(path);
-    if (!file) throw FileNotFound(path);
+void OrderManager::read(const std::string &path, unsigned threads) {
+    FileReader file(path);
+
+    // each part of the file ends with a separator, so that it only holds whole orders
+    std::vector<FileReader> parts = file.split(threads, '-');
+    std::vector<std::vector<OrderRecord>> records(parts.size());
+    std::vector<std::function<void()>> tasks;
+    for (std::size_t i = 0; i < parts.size(); ++i) tasks.emplace_back([&, i]() { records[i] = parse(parts[i]); });
+    util::runInParallel(tasks, threads);
 
+    for (const auto& part : records)
+        for (const auto& record : part) add(record);
+}
+
+std::vector<OrderManager::OrderRecord> OrderManager::parse(FileReader &file) {
     auto getDate = [](std::string dateStr, std::string timeStr) {
         int day = 1, month = 1, year = 1900, hour = 0, minute = 0;
         std::replace(dateStr.begin(), dateStr.end(), '/', ' ');
@@ -155,148 +195,485 @@ void OrderManager::read(const std::string &path) {
         return Date(day, month, year, hour, minute);
     };
 
-    auto getProduct = [&](const std::string &productLine) {
-        std::string productName;
-        float price = 1;
-        int quantity = 1;
-
-        std::stringstream ss(productLine);
-        ss >> productName >> price >> quantity;
-        std::replace(productName.begin(),productName.end(),'-',' ');
-        Product *product = _productManager->get(productName, price);
-        return product;
-    };
-
+    std::vector<OrderRecord> records;
     bool readDetails = true;
-    Order *order = nullptr;
-    int clientEvaluation = -1;
 
-    for (std::string line; getline(file, line);) {
-        util::stripCarriageReturn(line);
-        if (line.empty()) continue;
+    while (file.nextLine()) {
+        if (file.isLineEmpty()) continue;
 
         if (readDetails) {
             readDetails = false;
-            clientEvaluation = -1;
-            std::string date, time, location;
-            unsigned long clientTaxID = Person::DEFAULT_TAX_ID, workerTaxID = Person::DEFAULT_TAX_ID;
-
-            std::stringstream ss(line);
-            ss >> clientTaxID >> workerTaxID >> date >> time >> location >> clientEvaluation;
-
-            Client* client = _clientManager->getClient(clientTaxID);
-            Worker* worker = _workerManager->getWorker(workerTaxID);
-            std::replace(location.begin(),location.end(),'-',' ');
-
-            Order toTest(*client,*worker,location,getDate(date,time));
-            if (has(&toTest)) {
-                order = get(client,worker,location,getDate(date,time));
-                continue;
-            }
-            order = add(client, worker, location, getDate(date, time));
+            OrderRecord record;
+            const char *date = "", *dateEnd = date, *time = "", *timeEnd = time;
+
+            file.read(record.clientTaxID);
+            file.read(record.workerTaxID);
+            file.readField(date, dateEnd);
+            file.readField(time, timeEnd);
+            file.read(record.location, true);
+            file.read(record.clientEvaluation);
+
+            // dates are saved as DD/MM/YYYY HH:MM, anything else goes through the lenient parser
+            if (dateEnd - date != Date::CALENDAR_DAY_SIZE || timeEnd - time != Date::CLOCK_TIME_SIZE
+                || !Date::parse(date, time, record.date))
+                record.date = getDate(std::string(date, dateEnd), std::string(time, timeEnd));
+            records.push_back(std::move(record));
         }
-        else if (line.at(0) == '-') {
-            if (order && !order->wasDelivered() && clientEvaluation != -1){
-                // client points are kept in the client file, so do not change them
-                deliver(order, clientEvaluation, false);
-            }
+        else if (file.lineFront() == '-') {
+            records.back().closed = true;
             readDetails = true;
-            order = nullptr;
         }
         else {
-            Product *product = getProduct(line);
-            if (!order) throw OrderDoesNotExist();
-            if (!order->wasDelivered() && _productManager->has(product)) addProduct(order,product);
+            std::string productName;
+            float price = 1;
+
+            file.read(productName, true);
+            file.read(price);
+            records.back().products.emplace_back(std::move(productName), price);
+        }
+    }
+    return records;
+}
+
+void OrderManager::add(const OrderRecord &record) {
+    Client* client = _clientManager->getClient(record.clientTaxID);
+    Worker* worker = _workerManager->getWorker(record.workerTaxID);
+
+    const Location* location = Location::find(record.location);
+    Order* order = nullptr;
+    if (location){
+        Order toTest(*client, *worker, *location, record.date);
+        auto position = find(&toTest);
+        if (position != _orders.end()) order = position->getOrder();
+    }
+    if (!order) order = add(client, worker, record.location, record.date);
+
+    // the products of each order are included at once, so that the products list is updated in a single pass
+    std::unordered_map<Product*, unsigned> previousInclusions;
+    for (const auto& productData : record.products){
+        Product *product = _productManager->get(productData.first, productData.second);
+        if (order->wasDelivered()) continue;
+        // the products list is keyed by the counter from before this order, so check each product before including it
+        if (!previousInclusions.count(product)){
+            if (!_productManager->has(product)) continue;
+            previousInclusions.emplace(product, product->getTimesIncluded());
         }
+        order->addProduct(product);
+    }
+    _productManager->update(previousInclusions);
+
+    if (record.closed && !order->wasDelivered() && record.clientEvaluation != -1){
+        // client points are kept in the client file, so do not change them
+        deliver(order, record.clientEvaluation, false);
     }
 }
 
 void OrderManager::write(const std::string &path) {
-    std::ofstream file(path);
-    if (!file) throw FileNotFound(path);
-
-    std::priority_queue<OrderEntry> tmpOrders = _orders;
-    for(; !tmpOrders.empty(); tmpOrders.pop()){
-        const auto& order = _orders.top().getOrder();
-        std::string styledLocationName = order->getDeliverLocation();
-        std::replace(styledLocationName.begin(),styledLocationName.end(),' ','-');
-        file << order->getClient()->getTaxId() << " " << order->getWorker()->getTaxId() << " "
-             << order->getRequestDate().getCompleteDate() << " " << styledLocationName;
-        if (order->wasDelivered()) file << " " << order->getClientEvaluation();
-        file << "\n";
+    FileWriter file(path);
+
+    // the orders are written straight from the queue, without copying it
+    for(const auto& orderEntry : _orders){
+        const auto& order = orderEntry.getOrder();
+        const Date& date = order->getRequestDate();
+        file.write(order->getClient()->getTaxId()).write(' ').write(order->getWorker()->getTaxId()).write(' ')
+            .write(date.getDay(), 2).write('/')
+            .write(date.getMonth(), 2).write('/')
+            .write(date.getYear(), 4).write(' ')
+            .write(date.getHour(), 2).write(':')
+            .write(date.getMinute(), 2).write(' ')
+            .write(order->getDeliverLocation(), true);
+        if (order->wasDelivered()) file.write(' ').write(order->getClientEvaluation());
+        file.write('\n');
 
         for (const auto& p : order->getProducts()) {
-            std::string nameToSave = p.first->getName();
-            std::replace(nameToSave.begin(),nameToSave.end(),' ','-');
-            file << nameToSave << " " << p.first->getPrice() << " " << p.second << "\n";
+            file.write(p.first->getName(), true).write(' ').write(p.first->getPrice()).write(' ')
+                .write(static_cast<unsigned long>(p.second)).write('\n');
         }
-        file << util::SEPARATOR;
+        file.write(util::SEPARATOR);
     }
+    file.close();
 }
 
 OrderManager::~OrderManager() {
-    for(; !_orders.empty(); _orders.pop()){
-        delete _orders.top().getOrder();
+    for(const auto& orderEntry : _orders){
+        delete orderEntry.getOrder();
     }
 }
 
-std::priority_queue<OrderEntry> OrderManager::get(const std::string &location) const {
-    std::priority_queue<OrderEntry> filtered, tmpOrders = _orders;
-    for (; !tmpOrders.empty(); tmpOrders.pop()){
-        auto orderEntry = tmpOrders.top();
-        if(orderEntry.getOrder()->getDeliverLocation() == location) filtered.push(orderEntry);
-    }
-    return filtered;
+std::priority_queue<OrderEntry> OrderManager::get(const Location &location) const {
+    const OrderQueue& orders = getOrders(location);
+    return std::priority_queue<OrderEntry>(orders.begin(), orders.end());
 }
 
 Order* OrderManager::get(Client *client, Worker *worker, const std::string &location, const Date &date) {
-    std::priority_queue<OrderEntry> tmpOrders = _orders;
-    Order toTest = Order(*client, *worker, location, date);
-    for (; !tmpOrders.empty(); tmpOrders.pop()){
-        const auto& order = tmpOrders.top().getOrder();
-        if (*order == toTest) return order;
-    }
-    throw OrderDoesNotExist();
+    const Location* interned = Location::find(location);
+    if (!interned) throw OrderDoesNotExist();
+    Order toTest = Order(*client, *worker, *interned, date);
+    auto position = find(&toTest);
+    if (position == _orders.end()) throw OrderDoesNotExist();
+    return position->getOrder();
 }
 
 Product *OrderManager::addProduct(Order *order, Product *product, unsigned int quantity) {
     if (!has(order)) throw OrderDoesNotExist();
-    _productManager->remove(product);
+    unsigned previousInclusions = product->getTimesIncluded();
     order->addProduct(product,quantity);
-    _productManager->add(product);
+    _productManager->update(product, previousInclusions);
+    journal(JournalOperation::ORDER_PRODUCT_ADDED, order, product, quantity);
     return product;
 }
 
 void OrderManager::removeProduct(Order *order, Product *product) {
     if (!has(order)) throw OrderDoesNotExist();
-    _productManager->remove(product);
+    unsigned previousInclusions = product->getTimesIncluded();
     order->removeProduct(product);
-    _productManager->add(product);
+    _productManager->update(product, previousInclusions);
+    journal(JournalOperation::ORDER_PRODUCT_REMOVED, order, product);
 }
 
 void OrderManager::removeProduct(Order *order, unsigned long position) {
     if (!has(order)) throw OrderDoesNotExist();
 
-    auto orderProd = order->getProducts();
-    auto it = orderProd.begin();
+    const OrderProducts& orderProd = order->getProducts();
     if (position >= orderProd.size()) throw std::invalid_argument("Invalid product position");
-    std::advance(it,position);
 
-    _productManager->remove(it->first);
+    Product* product = orderProd.begin()[position].first;
+    unsigned previousInclusions = product->getTimesIncluded();
     order->removeProduct(position);
-    _productManager->add(it->first);
+    _productManager->update(product, previousInclusions);
+    journal(JournalOperation::ORDER_PRODUCT_REMOVED, order, product);
 }
 
-void OrderManager::setDeliveryLocation(Order *order, const string &location) {
-    order->getWorker()->removeOrderToDeliver();
-    Worker* newWorker = _workerManager->getLessBusyWorker(location);
-    order->setDeliverLocation(location,newWorker);
-    order->getWorker()->addOrderToDeliver();
+void OrderManager::setDeliveryLocation(Order *order, const string &location, Worker* worker) {
+    if (order->wasDelivered()) throw OrderWasAlreadyDelivered(*order->getClient(),*order->getWorker(),order->getRequestDate());
+    if (!_locationManager->has(location)) throw LocationDoesNotExist(location);
+    const Location interned(location);
+    Worker* newWorker = worker ? worker : _workerManager->getLessBusyWorker(interned);
+    if (!_workerManager->has(newWorker)) throw PersonDoesNotExist(newWorker->getName(), newWorker->getTaxId());
+    auto position = find(order);
+    if (position == _orders.end()) throw OrderDoesNotExist();
+    if (_journal){
+        JournalEntry entry(JournalOperation::ORDER_LOCATION_CHANGED);
+        entry.writeOrder(order);
+        entry.writeString(location);
+        entry.writePerson(newWorker);
+        _journal->record(entry);
+    }
+    erase(position);
+    _workerManager->removeOrderToDeliver(order->getWorker());
+    order->setDeliverLocation(interned,newWorker);
+    _workerManager->addOrderToDeliver(order->getWorker());
+    insert(order);
 }
 
 void OrderManager::deliver(Order *order, int clientEvaluation, bool updatePoints, int deliverDuration) {
-    remove(order, false, false);
+    if(order->wasDelivered()) throw OrderWasAlreadyDelivered(*order->getClient(),*order->getWorker(),order->getRequestDate());
+    auto position = find(order);
+    if (position == _orders.end()) throw OrderDoesNotExist();
+
+    // the queue entries keep the priority the order had when it was inserted, so it can be delivered before erasing
     order->deliver(clientEvaluation, updatePoints, deliverDuration);
-    order->getWorker()->removeOrderToDeliver();
-    _orders.push(OrderEntry(order));
+    if (_journal){
+        JournalEntry entry(JournalOperation::ORDER_DELIVERED);
+        entry.writeOrder(order);
+        entry.writeUInt8(static_cast<std::uint8_t>(clientEvaluation));
+        entry.writeUInt8(updatePoints);
+        // the actual duration, since a duration of 0 stands for the time of the delivery
+        entry.writeUInt32(static_cast<std::uint32_t>(order->getDeliverDate().getMinutes()
+                                                     - order->getRequestDate().getMinutes()));
+        _journal->record(entry);
+    }
+    erase(position);
+    _workerManager->removeOrderToDeliver(order->getWorker());
+    insert(order);
+    reprioritize(order->getClient());
+
+    ++_deliveredCount;
+    _evaluationsSum += static_cast<unsigned long>(clientEvaluation);
+    _revenue += order->getFinalPrice();
+    _analytics.add(order);
+
+    addToSketches(order->getDeliverLocationHandle(), order->getWorker(), order->getFinalPrice(),
+                  order->getDeliverDate().getMinutes() - order->getRequestDate().getMinutes());
+}
+
+void OrderManager::removeWorker(Worker *worker) {
+    _workerManager->remove(worker);
+    _sketchesByWorker.erase(worker);
+}
+
+void OrderManager::addToSketches(const Location &location, const Worker *worker, float value, std::int32_t latency) {
+    std::vector<DeliverySketches*> sketches{&_sketchesByLocation[location]};
+    if (worker) sketches.push_back(&_sketchesByWorker[worker]);
+    for (DeliverySketches* sketch : sketches){
+        sketch->value.add(value);
+        sketch->latency.add(static_cast<float>(latency));
+    }
+}
+
+unsigned long OrderManager::openArchive(const std::string &path) {
+    _archive.open(path);
+    // from now on, orders are only archived after they were added to the sketches
+    const bool feedSketches = !_sketchesHoldArchive;
+    _sketchesHoldArchive = true;
+    if (!_archive.getSize()) return 0;
+
+    // people with the default taxpayer identification number are found by name, as on the journal
+    std::unordered_map<std::string, Client*> clientsByName;
+    for (const auto& client : _clientManager->getAll())
+        if (client->getTaxId() == Person::DEFAULT_TAX_ID) clientsByName.emplace(client->getName(), client);
+    std::unordered_map<std::string, Worker*> workersByName;
+    for (const auto& worker : _workerManager->getAll())
+        if (worker->getTaxId() == Person::DEFAULT_TAX_ID) workersByName.emplace(worker->getName(), worker);
+
+    std::unordered_set<const Client*> evaluatedClients;
+    unsigned long stillLive = 0;
+    for (const auto& order : _archive.get()){
+        // the evaluations of the archived orders were only kept on the people, which are rebuilt from the live orders
+        Client* client = nullptr;
+        Worker* worker = nullptr;
+        if (order.clientTaxID != Person::DEFAULT_TAX_ID){
+            try { client = _clientManager->getClient(order.clientTaxID); }
+            catch (PersonDoesNotExist&) {}
+        }
+        else if (clientsByName.count(order.clientName)) client = clientsByName.at(order.clientName);
+        if (order.workerTaxID != Person::DEFAULT_TAX_ID){
+            try { worker = _workerManager->getWorker(order.workerTaxID); }
+            catch (PersonDoesNotExist&) {}
+        }
+        else if (workersByName.count(order.workerName)) worker = workersByName.at(order.workerName);
+
+        // if the application stopped after the segment was saved and before the following checkpoint, the order is
+        // still live and already counted everywhere, so only the live copy is dropped
+        const Location* location = Location::find(order.location);
+        if (client && worker && location){
+            Order archived(*client, *worker, *location, order.requestDate);
+            auto position = find(&archived);
+            if (position != _orders.end() && position->getOrder()->wasDelivered()){
+                discardArchived(position->getOrder());
+                ++stillLive;
+                continue;
+            }
+        }
+
+        _analytics.add(order, *_productManager);
+        if (feedSketches)
+            addToSketches(Location(order.location), worker, order.finalPrice,
+                          order.deliverDate.getMinutes() - order.requestDate.getMinutes());
+        if (client){
+            float total = 0;
+            for (const auto& product : order.products)
+                total += std::get<1>(product) * static_cast<float>(std::get<2>(product));
+            client->addEvaluation(order.clientEvaluation);
+            // a discount takes at least 2% off the total
+            if (order.finalPrice < 0.99f * total) client->addDiscount();
+            evaluatedClients.insert(client);
+        }
+        if (worker) worker->addDelivery(static_cast<unsigned>(order.clientEvaluation), order.finalPrice, order.deliverDate);
+    }
+    for (const auto& client : evaluatedClients) reprioritize(client);
+    return stillLive;
+}
+
+unsigned long OrderManager::archive(const Date &deliveredBefore) {
+    if (!_archive.isOpen()) throw std::logic_error("The orders archive was not opened.");
+
+    // delivered orders are at the end of the queue
+    std::vector<const Order*> toArchive;
+    for (auto it = _orders.rbegin(); it != _orders.rend() && it->getOrder()->wasDelivered(); ++it)
+        if (it->getOrder()->getDeliverDate() < deliveredBefore) toArchive.push_back(it->getOrder());
+    if (toArchive.empty()) return 0;
+
+    // the segment is saved first, so that no order is lost if it can't be written
+    _archive.add(toArchive);
+    for (const auto& order : toArchive) discardArchived(const_cast<Order*>(order));
+    return toArchive.size();
+}
+
+void OrderManager::discardArchived(Order *order) {
+    if (!order->wasDelivered()) throw OrderWasNotDeliveredYet(*order->getClient(), *order->getWorker(), order->getRequestDate());
+    auto position = find(order);
+    if (position == _orders.end()) throw OrderDoesNotExist();
+    erase(position);
+
+    --_deliveredCount;
+    _evaluationsSum -= static_cast<unsigned long>(order->getClientEvaluation());
+    _revenue -= order->getFinalPrice();
+    delete order;
+}
+
+const OrderArchive &OrderManager::getArchive() const {
+    return _archive;
+}
+
+const OrderAnalytics &OrderManager::getAnalytics() const {
+    return _analytics;
+}
+
+const DeliverySketches &OrderManager::getSketches(const Location &location) const {
+    auto indexed = _sketchesByLocation.find(location);
+    return indexed != _sketchesByLocation.end() ? indexed->second : EMPTY_SKETCHES;
+}
+
+const DeliverySketches &OrderManager::getSketches(const Worker *worker) const {
+    auto indexed = _sketchesByWorker.find(worker);
+    return indexed != _sketchesByWorker.end() ? indexed->second : EMPTY_SKETCHES;
+}
+
+DeliverySketches OrderManager::getSketches() const {
+    DeliverySketches all;
+    for (const auto& location : _sketchesByLocation){
+        all.value.merge(location.second.value);
+        all.latency.merge(location.second.latency);
+    }
+    return all;
+}
+
+void OrderManager::writeSketches(BinaryWriter &file,
+                                 const std::unordered_map<const Worker *, std::uint32_t> &workerIds) const {
+    // the sketches are written by location name and by worker identifier, so that equal stores write equal files
+    std::map<std::string, const DeliverySketches*> byLocation;
+    for (const auto& location : _sketchesByLocation) byLocation.emplace(location.first.getName(), &location.second);
+    std::map<std::uint32_t, const DeliverySketches*> byWorker;
+    for (const auto& worker : _sketchesByWorker){
+        auto id = workerIds.find(worker.first);
+        if (id != workerIds.end()) byWorker.emplace(id->second, &worker.second);
+    }
+
+    file.writeUInt32(static_cast<std::uint32_t>(byLocation.size()));
+    for (const auto& location : byLocation){
+        file.writeString(location.first);
+        location.second->value.write(file);
+        location.second->latency.write(file);
+    }
+    file.writeUInt32(static_cast<std::uint32_t>(byWorker.size()));
+    for (const auto& worker : byWorker){
+        file.writeUInt32(worker.first);
+        worker.second->value.write(file);
+        worker.second->latency.write(file);
+    }
+}
+
+void OrderManager::readSketches(BinaryReader &file, const std::vector<Worker*> &workers) {
+    _sketchesByLocation.clear();
+    _sketchesByWorker.clear();
+    _sketchesHoldArchive = true;
+    for (std::uint32_t i = 0, count = file.readUInt32(); i < count; ++i){
+        DeliverySketches& sketches = _sketchesByLocation[Location(file.readString())];
+        sketches.value = QuantileSketch::read(file);
+        sketches.latency = QuantileSketch::read(file);
+    }
+    for (std::uint32_t i = 0, count = file.readUInt32(); i < count; ++i){
+        std::uint32_t id = file.readUInt32();
+        if (id >= workers.size()) throw InvalidFile(file.getPath());
+        DeliverySketches& sketches = _sketchesByWorker[workers[id]];
+        sketches.value = QuantileSketch::read(file);
+        sketches.latency = QuantileSketch::read(file);
+    }
+}
+
+unsigned long OrderManager::getDeliveredCount() const {
+    return _deliveredCount;
+}
+
+unsigned long OrderManager::getEvaluationsSum() const {
+    return _evaluationsSum;
+}
+
+float OrderManager::getRevenue() const {
+    return static_cast<float>(_revenue);
+}
+
+bool OrderManager::recomputeTotals() {
+    unsigned long deliveredCount = 0, evaluationsSum = 0;
+    double revenue = 0;
+    // delivered orders are at the end of the queue
+    for (auto it = _orders.rbegin(); it != _orders.rend() && it->getOrder()->wasDelivered(); ++it){
+        ++deliveredCount;
+        evaluationsSum += static_cast<unsigned long>(it->getOrder()->getClientEvaluation());
+        revenue += it->getOrder()->getFinalPrice();
+    }
+
+    bool matched = deliveredCount == _deliveredCount && evaluationsSum == _evaluationsSum
+            && static_cast<float>(revenue) == static_cast<float>(_revenue);
+    _deliveredCount = deliveredCount;
+    _evaluationsSum = evaluationsSum;
+    _revenue = revenue;
+    return matched;
+}
+
+void OrderManager::reprioritize(const Client *client) {
+    auto clientOrders = _ordersByClient.find(client);
+    if (clientOrders == _ordersByClient.end()) return;
+
+    std::vector<Order*> outdated;
+    for (const auto& orderEntry : clientOrders->second){
+        const OrderPriority current = orderEntry.getOrder()->getPriority();
+        if (current < orderEntry.getPriority() || orderEntry.getPriority() < current)
+            outdated.push_back(orderEntry.getOrder());
+    }
+    for (const auto& order : outdated){
+        erase(_ordersById.at(order->getId()));
+        insert(order);
+    }
+}
+
+OrderQueue::const_iterator OrderManager::find(const Order *order) const {
+    auto indexed = _ordersById.find(order->getId());
+    if (indexed != _ordersById.end() && indexed->second->getOrder() == order) return indexed->second;
+
+    // orders built outside the manager have no identifier, so they can only be matched by value
+    auto clientOrders = _ordersByClient.find(order->getClient());
+    if (clientOrders != _ordersByClient.end()){
+        for (const auto& orderEntry : clientOrders->second){
+            if (*orderEntry.getOrder() == *order) return _ordersById.at(orderEntry.getOrder()->getId());
+        }
+        return _orders.end();
+    }
+    for (auto it = _orders.begin(); it != _orders.end(); ++it){
+        if (*it->getOrder() == *order) return it;
+    }
+    return _orders.end();
+}
+
+void OrderManager::setJournal(Journal *journal) {
+    _journal = journal;
+}
+
+void OrderManager::journal(JournalOperation operation, const Order *order, const Product *product, unsigned quantity) {
+    if (!_journal) return;
+    JournalEntry entry(operation);
+    entry.writeOrder(order);
+    if (product) entry.writeProduct(product);
+    if (quantity) entry.writeUInt32(quantity);
+    _journal->record(entry);
+}
+
+void OrderManager::insert(Order *order) {
+    if (!order->_id) order->_id = ++_lastOrderId;
+    OrderEntry orderEntry(order);
+    _ordersById[order->_id] = _orders.insert(orderEntry).first;
+    _ordersByClient[order->getClient()].insert(orderEntry);
+    _ordersByWorker[order->getWorker()].insert(orderEntry);
+    _ordersByLocation[order->getDeliverLocationHandle()].insert(orderEntry);
+}
+
+void OrderManager::erase(OrderQueue::const_iterator position) {
+    const OrderEntry orderEntry = *position;
+    const Order* order = orderEntry.getOrder();
+
+    auto clientOrders = _ordersByClient.find(order->getClient());
+    clientOrders->second.erase(orderEntry);
+    if (clientOrders->second.empty()) _ordersByClient.erase(clientOrders);
+
+    auto workerOrders = _ordersByWorker.find(order->getWorker());
+    workerOrders->second.erase(orderEntry);
+    if (workerOrders->second.empty()) _ordersByWorker.erase(workerOrders);
+
+    auto locationOrders = _ordersByLocation.find(order->getDeliverLocationHandle());
+    locationOrders->second.erase(orderEntry);
+    if (locationOrders->second.empty()) _ordersByLocation.erase(locationOrders);
+
+    _ordersById.erase(order->getId());
+    _orders.erase(position);
 }
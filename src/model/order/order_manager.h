@@ -3,6 +3,9 @@
 #define FEUP_AEDA_PROJECT_ORDER_MANAGER_H
 
 #include "order.h"
+#include "order_archive.h"
+#include "order_analytics.h"
+#include "util/quantile_sketch.h"
 
 #include "model/product/product_manager.h"
 #include "model/person/client/client_manager.h"
@@ -12,40 +15,58 @@
 
 #include <algorithm>
 #include <queue>
+#include <set>
+#include <unordered_map>
 #include "model/store/location_manager.h"
+#include "model/store/journal.h"
+
+class FileReader;
 
 /**
  * Class which encapsulates a Order* and allows operators to be overloaded for them.
+ * The fields that decide the order priority are copied when the entry is created, so that an ordered container of
+ * entries stays consistent even if the client evaluations change afterwards.
  */
 class OrderEntry{
 public:
     /**
      * Create a new null OrderEntry object.
      */
-    OrderEntry() : _order(nullptr){};
+    OrderEntry() : _order(nullptr), _priority() {};
     /**
      * Create a new OrderEntry object.
      * @param order
      */
-    explicit OrderEntry(Order* order) : _order(order) {};
+    explicit OrderEntry(Order* order) : OrderEntry() { setOrder(order); };
     /**
      * Get the Order* which the OrderEntry encapsulates
      * @return the pointer to the order
      */
     Order* getOrder() const { return _order; };
     /**
-     * Sets a new order
+     * Get the order priority when the OrderEntry was created.
+     * @return the order priority
+     */
+    const OrderPriority& getPriority() const { return _priority; };
+    /**
+     * Sets a new order and takes a new snapshot of its priority.
      * @param order the order to be set
      */
-    void setOrder(Order* order) { _order = order; };
+    void setOrder(Order* order) {
+        _order = order;
+        if (order) _priority = order->getPriority();
+    };
     /**
-     * A OrderEntry comparison is based on the Order defined operator.
+     * A OrderEntry comparison follows the Order defined operator, applied to the priority snapshot.
+     * Ties are broken by the order identifier, so that older orders come first.
      * @param rhs the product to be compared to
      * @return the inequality of the orders
      */
     bool operator<(const OrderEntry& rhs) const{
         if(!getOrder() || !rhs.getOrder()) return false;
-        return *getOrder() < *rhs.getOrder();
+        if (_priority < rhs._priority) return true;
+        if (rhs._priority < _priority) return false;
+        return getOrder()->getId() > rhs.getOrder()->getId();
     }
     /**
      * A OrderEntry comparison is based on the Order defined operator.
@@ -61,6 +82,47 @@ private:
      * The pointer that is encapsulated.
      */
     Order* _order;
+
+    /**
+     * The order priority when the entry was created.
+     */
+    OrderPriority _priority;
+};
+
+/**
+ * Struct to sort order entries from the highest to the lowest delivery priority.
+ */
+struct OrderEntryGreater{
+    /**
+     * Checks if an order entry should be delivered before another.
+     *
+     * @param e1 the first entry to compare with
+     * @param e2 the second entry to compare with
+     * @return true, if e1 has more priority than e2
+     */
+    bool operator()(const OrderEntry& e1, const OrderEntry& e2) const {
+        return e2 < e1;
+    }
+};
+
+/**
+ * Orders sorted by delivery priority.
+ */
+typedef std::set<OrderEntry, OrderEntryGreater> OrderQueue;
+
+/**
+ * The sketches of the distribution of the final price and of the delivery time of the delivered orders.
+ */
+struct DeliverySketches {
+    /**
+     * The final prices of the orders, in euros.
+     */
+    QuantileSketch value;
+
+    /**
+     * The time between the request and the delivery of the orders, in minutes.
+     */
+    QuantileSketch latency;
 };
 
 /**
@@ -94,6 +156,8 @@ public:
     /**
      * Gets the order, at a certain position, either from the orders queue of the client, or from the orders queue of the
      * worker. If neither is provided, all orders are considered to count the position.
+     * The queues are sorted sets, so this walks from the first order and takes time linear in the position; code which
+     * goes through several orders should iterate over getOrders() instead of calling this for each position.
      *
      * @param position the position
      * @param client the client
@@ -103,12 +167,43 @@ public:
     Order* get(unsigned long position, Client* client = nullptr, Worker* worker = nullptr) const;
 
     /**
-     * Gets the list of all orders.
+     * Gets a copy of the list of all orders.
      *
      * @return the list of all orders
      */
     std::priority_queue<OrderEntry> getAll() const;
 
+    /**
+     * Gets the orders sorted by delivery priority, without copying them.
+     *
+     * @return the orders queue
+     */
+    const OrderQueue& getOrders() const;
+
+    /**
+     * Gets the orders requested by a certain client sorted by delivery priority, without copying them.
+     *
+     * @param client the client
+     * @return the client orders queue
+     */
+    const OrderQueue& getOrders(const Client* client) const;
+
+    /**
+     * Gets the orders assigned to a certain worker sorted by delivery priority, without copying them.
+     *
+     * @param worker the worker
+     * @return the worker orders queue
+     */
+    const OrderQueue& getOrders(const Worker* worker) const;
+
+    /**
+     * Gets the orders to be delivered at a certain location sorted by delivery priority, without copying them.
+     *
+     * @param location the delivery location
+     * @return the location orders queue
+     */
+    const OrderQueue& getOrders(const Location& location) const;
+
     /**
      * Gets the pointer to the order with provided details.
      *
@@ -142,7 +237,7 @@ public:
      * @param location the store location
      * @return the orders list relative to that store location
      */
-    std::priority_queue<OrderEntry> get(const std::string& location) const;
+    std::priority_queue<OrderEntry> get(const Location& location) const;
 
     /**
      * Adds a new order to the orders list created from that data: client, store location and date.
@@ -173,7 +268,8 @@ public:
     void remove(Order* order, bool updateWorkerOrders = true, bool destroy = true);
 
     /**
-     * Removes an order from the orders list at a certain position.
+     * Removes an order from the orders list at a certain position. Like get(position), this takes time linear in the
+     * position; removing an order by its pointer takes logarithmic time.
      *
      * @param position the position
      */
@@ -208,8 +304,9 @@ public:
      * in the newly requested location (if possible, working in that location) and frees the old one from the duty.
      * @param order the order to change the delivery location; should be in the queue
      * @param location the new delivery location
+     * @param worker the new worker; if nullptr, the less busy worker of the new location
      */
-    void setDeliveryLocation(Order* order, const std::string& location);
+    void setDeliveryLocation(Order* order, const std::string& location, Worker* worker = nullptr);
 
     /**
      * Wrapper to Order::deliver(...) which updates the orders queue to reflect the deliverance of the order
@@ -222,15 +319,35 @@ public:
      */
     void deliver(Order* order, int clientEvaluation, bool updatePoints = true, int deliverDuration = 30);
 
+    /**
+     * Removes a worker from the store, along with the sketches of its orders, which are no longer shown nor saved.
+     * Its orders, and so its deliveries on the sketches of their locations, are kept.
+     *
+     * @param worker the worker
+     * @throws PersonDoesNotExist if the worker doesn't exist
+     */
+    void removeWorker(Worker* worker);
+
+    /**
+     * Updates the position of the client orders on the orders queues after the client mean evaluation or number
+     * of discounts changed. Only the client orders are moved, so that the rest of the queues is left untouched.
+     *
+     * @param client the client
+     */
+    void reprioritize(const Client* client);
+
     /**
      * Reads all the orders on the file and its data: request date, products (name, price and requested quantity),
      * client (taxpayer identification number), worker (taxpayer identification number), delivery date (if the order was
      * already delivered) and order evaluation (also in case the order was already delivered). Then it adds each order
      * to the orders list.
+     * The file can be parsed by several threads, each one taking a block of orders, while the orders are still added
+     * one at a time in the order of the file, so that the result doesn't depend on the number of threads.
      *
      * @param path the file path
+     * @param threads the number of threads which parse the file
      */
-    void read(const std::string& path);
+    void read(const std::string& path, unsigned threads = 1);
 
     /**
      * Writes all the orders data on the orders list: client taxpayer identification number, worker taxpayer
@@ -253,7 +370,163 @@ public:
      */
     bool print(std::ostream& os, Client* client = nullptr, Worker* worker = nullptr) const;
 
+    /**
+     * Opens the archive where the delivered orders are moved to. The orders which were already archived are added to
+     * the analytics, and their evaluations to their clients and to the scorecards of their workers, which only hold
+     * the live orders after the store is loaded; so it must only be opened once, after the store is loaded. They are
+     * also added to the sketches, unless these were read from a snapshot, which keeps them.
+     * Archived orders which are still live, because the store was saved before they were archived, are already
+     * counted, so they are only removed from the orders list.
+     *
+     * @param path the archive path
+     * @return the number of archived orders which were still live
+     * @throws InvalidFile if the archive is corrupted
+     */
+    unsigned long openArchive(const std::string& path);
+
+    /**
+     * Moves the orders which were delivered before a certain date to a new segment of the archive.
+     *
+     * @param deliveredBefore the date
+     * @return the number of archived orders
+     * @throws std::logic_error if the archive wasn't opened
+     * @throws FileNotFound if the segment can't be written
+     */
+    unsigned long archive(const Date& deliveredBefore);
+
+    /**
+     * Removes a delivered order which was already saved on the archive. This isn't journaled: until the store is saved
+     * again, the order is live on the last snapshot, and opening the archive removes it.
+     *
+     * @param order the order
+     * @throws OrderWasNotDeliveredYet if the order wasn't delivered
+     * @throws OrderDoesNotExist if the order isn't on the orders list
+     */
+    void discardArchived(Order* order);
+
+    /**
+     * Gets the archive of delivered orders.
+     *
+     * @return the archive
+     */
+    const OrderArchive& getArchive() const;
+
+    /**
+     * Gets the analytics of the delivered orders, archived orders included.
+     *
+     * @return the analytics
+     */
+    const OrderAnalytics& getAnalytics() const;
+
+    /**
+     * Gets the order value and delivery time sketches of the orders delivered at a certain location.
+     *
+     * @param location the delivery location
+     * @return the sketches
+     */
+    const DeliverySketches& getSketches(const Location& location) const;
+
+    /**
+     * Gets the order value and delivery time sketches of the orders delivered by a certain worker.
+     *
+     * @param worker the worker
+     * @return the sketches
+     */
+    const DeliverySketches& getSketches(const Worker* worker) const;
+
+    /**
+     * Gets the order value and delivery time sketches of all delivered orders, merging the ones of each location.
+     *
+     * @return the sketches
+     */
+    DeliverySketches getSketches() const;
+
+    /**
+     * Writes the sketches of each location and of each worker.
+     *
+     * @param file the binary file
+     * @param workerIds the identifier of each worker on the file; sketches of other workers are left out
+     */
+    void writeSketches(BinaryWriter& file, const std::unordered_map<const Worker*, std::uint32_t>& workerIds) const;
+
+    /**
+     * Reads the sketches of each location and of each worker, replacing the current ones. The sketches saved on a
+     * snapshot also hold the orders which were archived by then.
+     *
+     * @param file the binary file
+     * @param workers the worker of each identifier on the file
+     * @throws InvalidFile if the sketches are corrupted
+     */
+    void readSketches(BinaryReader& file, const std::vector<Worker*>& workers);
+
+    /**
+     * Gets the number of delivered orders on the orders list (archived orders are not included).
+     *
+     * @return the number of delivered orders
+     */
+    unsigned long getDeliveredCount() const;
+
+    /**
+     * Gets the sum of the client evaluations of the delivered orders on the orders list.
+     *
+     * @return the evaluations sum
+     */
+    unsigned long getEvaluationsSum() const;
+
+    /**
+     * Gets the sum of the final prices of the delivered orders on the orders list.
+     *
+     * @return the revenue
+     */
+    float getRevenue() const;
+
+    /**
+     * Recomputes the delivered orders totals from the orders list, replacing the running ones.
+     *
+     * @return true, if the running totals matched the recomputed ones; false, otherwise
+     */
+    bool recomputeTotals();
+
+    /**
+     * Sets the journal where the changes to the orders list are recorded.
+     *
+     * @param journal the journal; nullptr, if the changes must not be recorded
+     */
+    void setJournal(Journal* journal);
+
 private:
+    /**
+     * The data of an order, as read from the orders file.
+     */
+    struct OrderRecord {
+        unsigned long clientTaxID = Person::DEFAULT_TAX_ID;
+        unsigned long workerTaxID = Person::DEFAULT_TAX_ID;
+        std::string location;
+        Date date;
+        int clientEvaluation = -1;
+        std::vector<std::pair<std::string, float>> products;
+
+        /**
+         * Whether the order was followed by a separator, after which it is delivered if it was evaluated.
+         */
+        bool closed = false;
+    };
+
+    /**
+     * Parses all the orders of a file, or of a part of it, without looking up or changing anything on the store.
+     *
+     * @param file the file
+     * @return the list of orders, in the order of the file
+     */
+    static std::vector<OrderRecord> parse(FileReader& file);
+
+    /**
+     * Adds an order read from the orders file, or includes its products on an order which was already added.
+     *
+     * @param record the data of the order
+     */
+    void add(const OrderRecord& record);
+
     /**
      * The store product manager.
      */
@@ -275,9 +548,135 @@ private:
     LocationManager* _locationManager;
 
     /**
-     * The queue of all orders. Delivered orders are kept in the end for historical reasons.
+     * Gets the position of an order on the orders queue by its identifier.
+     *
+     * @param order the order
+     * @return the position of the order on the orders queue; end of the queue, if it is not on the orders list
+     */
+    OrderQueue::const_iterator find(const Order* order) const;
+
+    /**
+     * Inserts an order on the orders queue and indexes it by its identifier, client, worker and delivery location.
+     * A new identifier is assigned to orders that do not have one yet.
+     *
+     * @param order the order
+     */
+    void insert(Order* order);
+
+    /**
+     * Erases an order from the orders queue and from all the orders indexes.
+     *
+     * @param position the position of the order on the orders queue
+     */
+    void erase(OrderQueue::const_iterator position);
+
+    /**
+     * Records an operation on an order, if there is a journal.
+     *
+     * @param operation the operation
+     * @param order the order
+     * @param product the product which was added or removed; nullptr, if there is none
+     * @param quantity the quantity of the product which was added; 0, if there is none
+     */
+    void journal(JournalOperation operation, const Order* order, const Product* product = nullptr,
+                 unsigned quantity = 0);
+
+    /**
+     * Adds a delivered order to the sketches of its location and of its worker.
+     *
+     * @param location the delivery location
+     * @param worker the worker; nullptr, if the worker no longer exists
+     * @param value the final price of the order
+     * @param latency the minutes between the request and the delivery
+     */
+    void addToSketches(const Location& location, const Worker* worker, float value, std::int32_t latency);
+
+    /**
+     * The queue returned when there are no orders for a certain client, worker or location.
+     */
+    static const OrderQueue EMPTY_QUEUE;
+
+    /**
+     * The sketches returned when there are no delivered orders for a certain location or worker.
+     */
+    static const DeliverySketches EMPTY_SKETCHES;
+
+    /**
+     * The queue of all orders. Delivered orders are kept in the end for historical reasons, until they are archived.
+     */
+    OrderQueue _orders;
+
+    /**
+     * The archive of delivered orders.
+     */
+    OrderArchive _archive;
+
+    /**
+     * The analytics of the delivered orders, which keep the archived ones too.
+     */
+    OrderAnalytics _analytics;
+
+    /**
+     * The order value and delivery time sketches of each delivery location.
+     */
+    std::unordered_map<Location, DeliverySketches, LocationHash> _sketchesByLocation;
+
+    /**
+     * The order value and delivery time sketches of each worker.
+     */
+    std::unordered_map<const Worker*, DeliverySketches> _sketchesByWorker;
+
+    /**
+     * Whether the sketches already hold the archived orders, as the ones read from a snapshot do; otherwise, they are
+     * added when the archive is opened.
+     */
+    bool _sketchesHoldArchive;
+
+    /**
+     * The position of each order on the orders queue, by order identifier.
+     */
+    std::unordered_map<unsigned long, OrderQueue::const_iterator> _ordersById;
+
+    /**
+     * The orders of each client, sorted by delivery priority.
+     */
+    std::unordered_map<const Client*, OrderQueue> _ordersByClient;
+
+    /**
+     * The orders of each worker, sorted by delivery priority.
+     */
+    std::unordered_map<const Worker*, OrderQueue> _ordersByWorker;
+
+    /**
+     * The orders of each delivery location, sorted by delivery priority.
+     */
+    std::unordered_map<Location, OrderQueue, LocationHash> _ordersByLocation;
+
+    /**
+     * The identifier of the last added order.
+     */
+    unsigned long _lastOrderId;
+
+    /**
+     * The number of delivered orders on the orders list.
+     */
+    unsigned long _deliveredCount;
+
+    /**
+     * The sum of the client evaluations of the delivered orders on the orders list.
+     */
+    unsigned long _evaluationsSum;
+
+    /**
+     * The sum of the final prices of the delivered orders on the orders list, kept in double precision so that
+     * adding and removing orders does not accumulate rounding errors.
+     */
+    double _revenue;
+
+    /**
+     * The journal where the changes are recorded.
      */
-    std::priority_queue<OrderEntry> _orders;
+    Journal* _journal;
 };
 
 #endif //FEUP_AEDA_PROJECT_ORDER_MANAGER_H
@@ -2,6 +2,7 @@
 #include "boss.h"
 
 #include "exception/file_exception.h"
+#include "util/file_reader.h"
 
 const char* Boss::DEFAULT_USERNAME = "boss";
 const char* Boss::DEFAULT_PASSWORD = "boss";
@@ -15,14 +16,15 @@ Credential Boss::getDefaultCredential() {
 }
 
 void Boss::read(const std::string &path) {
-    std::ifstream file(path);
-    if(!file) throw FileNotFound(path);
+    FileReader file(path);
 
     std::string name, username, password;
     unsigned long taxID = Person::DEFAULT_TAX_ID;
-    file >> name >> taxID >> username >> password;
-    util::stripCarriageReturn(password);
-    std::replace(name.begin(),name.end(),'-',' ');
+    while (file.nextLine() && file.isLineEmpty());
+    file.read(name, true);
+    file.read(taxID);
+    file.read(username);
+    file.read(password);
     setName(name);
     setTaxID(taxID);
     setCredential({username,password});
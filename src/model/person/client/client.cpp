@@ -2,13 +2,12 @@
 #include "client.h"
 
 #include "util/util.h"
-#include <numeric>
 
 const char* Client::DEFAULT_USERNAME = "client";
 const char* Client::DEFAULT_PASSWORD = "client";
 
 Client::Client(std::string name, unsigned long taxID, bool premium, Credential credential):
-        Person(std::move(name), taxID, std::move(credential), PersonRole::CLIENT), _points{0}, _premium(premium), _evaluations(), _numDiscounts(0){
+        Person(std::move(name), taxID, std::move(credential), PersonRole::CLIENT), _points{0}, _premium(premium), _evaluationsSum(0), _numEvaluations(0), _numDiscounts(0){
 }
 
 bool Client::isPremium() const {
@@ -68,12 +67,12 @@ void Client::setPoints(unsigned int points) {
 }
 
 void Client::addEvaluation(int evaluation) {
-    _evaluations.push_back(evaluation);
+    _evaluationsSum += evaluation;
+    _numEvaluations++;
 }
 
 float Client::getMeanEvaluation() const {
-    return _evaluations.empty()? 0 :
-    std::accumulate(_evaluations.begin(),_evaluations.end(),0.0f) / _evaluations.size();
+    return _numEvaluations == 0 ? 0 : static_cast<float>(_evaluationsSum) / _numEvaluations;
 }
 
 
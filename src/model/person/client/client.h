@@ -138,9 +138,14 @@ private:
     unsigned _points;
 
     /**
-     * The list of all order evaluations given by the client.
+     * The sum of all order evaluations given by the client.
      */
-    std::vector<int> _evaluations;
+    int _evaluationsSum;
+
+    /**
+     * The number of order evaluations given by the client.
+     */
+    unsigned _numEvaluations;
 
     /**
      * The times this client had order discounts (which are applied once the order is delivered).
@@ -3,8 +3,9 @@
 
 #include "client_manager.h"
 #include "exception/file_exception.h"
+#include "util/file_reader.h"
 
-ClientManager::ClientManager() : _clients() {
+ClientManager::ClientManager() : _clients(), _clientsByTaxID(), _clientsByUsername(), _journal(nullptr) {
 }
 
 ClientManager::~ClientManager() {
@@ -27,7 +28,17 @@ std::set<Client *, PersonSmaller> ClientManager::getAll() {
 
 Client* ClientManager::add(std::string name, unsigned long taxID, bool premium, Credential credential) {
     auto* client = new Client(std::move(name), taxID, premium, std::move(credential));
-    _clients.insert(client);
+    if (!_clients.insert(client).second) return client;
+    index(client);
+
+    if (_journal){
+        JournalEntry entry(JournalOperation::CLIENT_ADDED);
+        entry.writePerson(client);
+        entry.writeUInt8(client->isPremium());
+        entry.writeString(client->getCredential().username);
+        entry.writeString(client->getCredential().password);
+        _journal->record(entry);
+    }
     return client;
 }
 
@@ -35,15 +46,125 @@ void ClientManager::remove(Client *client) {
     auto position = _clients.find(client);
     if(position == _clients.end())
         throw PersonDoesNotExist(client->getName(), client->getTaxId());
+    if (_journal){
+        JournalEntry entry(JournalOperation::CLIENT_REMOVED);
+        entry.writePerson(*position);
+        _journal->record(entry);
+    }
+    unindex(*position);
     _clients.erase(position);
 }
 
 void ClientManager::remove(unsigned long position) {
     if(position >= _clients.size()) throw InvalidPersonPosition(position, _clients.size());
     auto it = _clients.begin(); std::advance(it, position);
+    if (_journal){
+        JournalEntry entry(JournalOperation::CLIENT_REMOVED);
+        entry.writePerson(*it);
+        _journal->record(entry);
+    }
+    unindex(*it);
     _clients.erase(it);
 }
 
+void ClientManager::setTaxID(Client *client, unsigned long taxID) {
+    auto position = _clients.find(client);
+    if (position == _clients.end() || *position != client)
+        throw PersonDoesNotExist(client->getName(), client->getTaxId());
+    if (taxID == client->getTaxId()) return;
+    if (taxID != Person::DEFAULT_TAX_ID && _clientsByTaxID.count(taxID)) throw PersonAlreadyExists(taxID);
+
+    JournalEntry entry(JournalOperation::CLIENT_TAX_ID_CHANGED);
+    entry.writePerson(client);
+    entry.writeUInt64(taxID);
+
+    // the clients list is sorted by taxpayer identification number, so the client must be moved
+    unsigned long previousTaxID = client->getTaxId();
+    unindex(client);
+    _clients.erase(position);
+    client->setTaxID(taxID);
+    if (!_clients.insert(client).second){
+        client->setTaxID(previousTaxID);
+        _clients.insert(client);
+        index(client);
+        throw PersonAlreadyExists(taxID);
+    }
+    index(client);
+    if (_journal) _journal->record(entry);
+}
+
+void ClientManager::setCredential(Client *client, const Credential &credential) {
+    auto position = _clients.find(client);
+    if (position == _clients.end() || *position != client)
+        throw PersonDoesNotExist(client->getName(), client->getTaxId());
+    if (credential.isReserved()) throw InvalidCredential();
+    if (_journal){
+        JournalEntry entry(JournalOperation::CLIENT_CREDENTIAL_CHANGED);
+        entry.writePerson(client);
+        entry.writeString(credential.username);
+        entry.writeString(credential.password);
+        _journal->record(entry);
+    }
+    unindex(client);
+    client->setCredential(credential);
+    index(client);
+}
+
+void ClientManager::setName(Client *client, const std::string &name) {
+    auto position = _clients.find(client);
+    if (position == _clients.end() || *position != client)
+        throw PersonDoesNotExist(client->getName(), client->getTaxId());
+    if (name == client->getName()) return;
+
+    JournalEntry entry(JournalOperation::CLIENT_NAME_CHANGED);
+    entry.writePerson(client);
+    entry.writeString(name);
+
+    // clients with the default taxpayer identification number are sorted by name, so the client must be moved
+    std::string previousName = client->getName();
+    _clients.erase(position);
+    client->setName(name);
+    if (!_clients.insert(client).second){
+        client->setName(previousName);
+        _clients.insert(client);
+        throw PersonAlreadyExists(client->getTaxId());
+    }
+    if (_journal) _journal->record(entry);
+}
+
+void ClientManager::setPremium(Client *client, bool premium) {
+    auto position = _clients.find(client);
+    if (position == _clients.end() || *position != client)
+        throw PersonDoesNotExist(client->getName(), client->getTaxId());
+    if (_journal){
+        JournalEntry entry(JournalOperation::CLIENT_PREMIUM_CHANGED);
+        entry.writePerson(client);
+        entry.writeUInt8(premium);
+        _journal->record(entry);
+    }
+    client->setPremium(premium);
+}
+
+void ClientManager::setJournal(Journal *journal) {
+    _journal = journal;
+}
+
+void ClientManager::index(Client *client) {
+    if (client->getTaxId() != Person::DEFAULT_TAX_ID) _clientsByTaxID[client->getTaxId()] = client;
+    _clientsByUsername.emplace(client->getCredential().username, client);
+}
+
+void ClientManager::unindex(Client *client) {
+    _clientsByTaxID.erase(client->getTaxId());
+    auto range = _clientsByUsername.equal_range(client->getCredential().username);
+    for (auto it = range.first; it != range.second; ++it){
+        if (it->second == client) {
+            _clientsByUsername.erase(it);
+            break;
+        }
+    }
+}
+
 bool ClientManager::print(std::ostream &os, bool showData) {
     if (_clients.empty()){
         os << "No clients yet.\n";
@@ -71,22 +192,22 @@ bool ClientManager::print(std::ostream &os, bool showData) {
 }
 
 void ClientManager::read(const std::string &path) {
-    std::ifstream file(path);
-    if(!file) throw FileNotFound(path);
+    FileReader file(path);
 
     std::string name, premium;
     unsigned long taxID = Person::DEFAULT_TAX_ID;
     unsigned points = 0;
     Credential credential;
 
-    for(std::string line; getline(file, line); ){
-        util::stripCarriageReturn(line);
-        if (line.empty()) continue;
-
-        std::stringstream ss(line);
-        ss>>name>>taxID>>premium>>points>>credential.username>>credential.password;
+    while (file.nextLine()){
+        if (file.isLineEmpty()) continue;
 
-        std::replace(name.begin(), name.end(), '-', ' ');
+        file.read(name, true);
+        file.read(taxID);
+        file.read(premium);
+        file.read(points);
+        file.read(credential.username);
+        file.read(credential.password);
         Client* client = add(name, taxID, premium == "premium", credential);
         client->setPoints(points);
     }
@@ -108,9 +229,22 @@ void ClientManager::write(const std::string &path) {
 }
 
 Client *ClientManager::getClient(unsigned long taxID) const{
+    if (taxID != Person::DEFAULT_TAX_ID){
+        auto indexed = _clientsByTaxID.find(taxID);
+        if (indexed != _clientsByTaxID.end()) return indexed->second;
+        throw PersonDoesNotExist(taxID);
+    }
+    // several clients may have the default taxpayer identification number
     for(const auto& _client : _clients){
         if (_client->getTaxId() == taxID) return _client;
     }
     throw PersonDoesNotExist(taxID);
 }
 
+std::vector<Client *> ClientManager::getByUsername(const std::string &username) const {
+    std::vector<Client*> res;
+    auto range = _clientsByUsername.equal_range(username);
+    for (auto it = range.first; it != range.second; ++it) res.push_back(it->second);
+    return res;
+}
+
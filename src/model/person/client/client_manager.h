@@ -4,9 +4,11 @@
 
 #include "client.h"
 #include "util/util.h"
+#include "model/store/journal.h"
 
 #include <iostream>
 #include <fstream>
+#include <unordered_map>
 
 /**
  * Class that manages the store clients.
@@ -47,6 +49,14 @@ public:
      */
     Client* getClient(unsigned long taxID) const;
 
+    /**
+     * Gets the clients whose login username is a certain one.
+     *
+     * @param username the login username
+     * @return the clients with that username
+     */
+    std::vector<Client*> getByUsername(const std::string& username) const;
+
     /**
      * Gets the clients list.
      *
@@ -66,6 +76,40 @@ public:
     Client* add(std::string name, unsigned long taxID = Person::DEFAULT_TAX_ID, bool premium = false,
                 Credential credential = {Client::DEFAULT_USERNAME, Client::DEFAULT_PASSWORD});
 
+    /**
+     * Sets the taxpayer identification number of a client on the clients list.
+     *
+     * @param client the client
+     * @param taxID the new taxpayer identification number
+     */
+    void setTaxID(Client* client, unsigned long taxID);
+
+    /**
+     * Sets the login credentials of a client on the clients list.
+     *
+     * @param client the client
+     * @param credential the new login credentials
+     */
+    void setCredential(Client* client, const Credential& credential);
+
+    /**
+     * Sets the name of a client on the clients list.
+     *
+     * @param client the client
+     * @param name the new name
+     * @throws PersonAlreadyExists if the client has the default taxpayer identification number and another one with
+     * that number already has that name
+     */
+    void setName(Client* client, const std::string& name);
+
+    /**
+     * Sets whether a client on the clients list is premium.
+     *
+     * @param client the client
+     * @param premium true, if the client becomes premium; false, otherwise
+     */
+    void setPremium(Client* client, bool premium);
+
     /**
      * Removes a client from the clients list.
      *
@@ -106,11 +150,47 @@ public:
      * @param path the file path
      */
     void write(const std::string& path);
+
+    /**
+     * Sets the journal where the changes to the clients list are recorded.
+     *
+     * @param journal the journal; nullptr, if the changes must not be recorded
+     */
+    void setJournal(Journal* journal);
 private:
+    /**
+     * Adds a client to the taxpayer identification number and username indexes.
+     *
+     * @param client the client
+     */
+    void index(Client* client);
+
+    /**
+     * Removes a client from the taxpayer identification number and username indexes.
+     *
+     * @param client the client
+     */
+    void unindex(Client* client);
+
     /**
      * The list of all the clients.
      */
     std::set<Client*, PersonSmaller> _clients;
+
+    /**
+     * The clients with a taxpayer identification number other than the default one, by that number.
+     */
+    std::unordered_map<unsigned long, Client*> _clientsByTaxID;
+
+    /**
+     * The clients by login username.
+     */
+    std::unordered_multimap<std::string, Client*> _clientsByUsername;
+
+    /**
+     * The journal where the changes are recorded.
+     */
+    Journal* _journal;
 };
 
 
@@ -1,6 +1,5 @@
 
 #include <util/util.h>
-#include <numeric>
 #include <utility>
 #include "worker.h"
 
@@ -10,12 +9,16 @@ const float Worker::DEFAULT_SALARY = 1000;
 const unsigned Worker::MAX_ORDERS_AT_A_TIME = 5;
 const float Worker::MINIMUM_SALARY = 0.0;
 
-Worker::Worker(std::string location, std::string name, unsigned long taxID, float salary, Credential credential):
+Worker::Worker(Location location, std::string name, unsigned long taxID, float salary, Credential credential):
         Person(std::move(name), taxID, std::move(credential), PersonRole::WORKER),
-        _salary{salary}, _undeliveredOrders(0), _evaluations(), _location(std::move(location)){
+        _salary{salary}, _undeliveredOrders(0), _scorecard(), _location(location){
     if (_salary < MINIMUM_SALARY) _salary = MINIMUM_SALARY;
 }
 
+Worker::Worker(const std::string &location, std::string name, unsigned long taxID, float salary, Credential credential):
+        Worker(Location(location), std::move(name), taxID, salary, std::move(credential)){
+}
+
 float Worker::getSalary() const {
     return _salary;
 }
@@ -24,7 +27,11 @@ unsigned Worker::getUndeliveredOrders() const {
     return _undeliveredOrders;
 }
 
-std::string Worker::getLocation() const {
+const std::string& Worker::getLocation() const {
+    return _location;
+}
+
+const Location& Worker::getLocationHandle() const {
     return _location;
 }
 
@@ -48,6 +55,9 @@ void Worker::print(std::ostream &os, bool showData) {
         os << util::column(util::to_string(getSalary()) + " euros")
         << util::column(std::to_string(getUndeliveredOrders()) + " orders")
         << util::column(getMeanEvaluation() != 0 ? util::to_string(getMeanEvaluation()) + " points" : "None yet")
+        << util::column(std::to_string(_scorecard.getDeliveries()) + " orders")
+        << util::column(_scorecard.getRecentDeliveries() != 0 ?
+                        util::to_string(_scorecard.getRecentMeanEvaluation()) + " points" : "None yet")
         << util::column(getLocation());
     }
     else os << util::column(isLogged() ? "Yes" : "No");
@@ -57,12 +67,15 @@ Credential Worker::getDefaultCredential() {
     return {DEFAULT_USERNAME, DEFAULT_PASSWORD};
 }
 
-void Worker::addEvaluation(unsigned int evaluation) {
-    _evaluations.push_back(evaluation);
+void Worker::addDelivery(unsigned evaluation, float revenue, const Date &deliverDate) {
+    _scorecard.addDelivery(evaluation, revenue, deliverDate);
+}
+
+const WorkerScorecard &Worker::getScorecard() const {
+    return _scorecard;
 }
 
 float Worker::getMeanEvaluation() const {
-    return _evaluations.empty()? 0 :
-           std::accumulate(_evaluations.begin(),_evaluations.end(),0.0f) / _evaluations.size();
+    return _scorecard.getMeanEvaluation();
 }
 
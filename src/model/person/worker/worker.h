@@ -3,6 +3,8 @@
 #define FEUP_AEDA_PROJECT_WORKER_H
 
 #include "model/person/person.h"
+#include "model/store/location.h"
+#include "worker_scorecard.h"
 
 #include <string>
 #include <vector>
@@ -22,9 +24,21 @@ public:
      * @param taxID the taxpayer identification number
      * @param credential the login credentials
      */
-    explicit Worker(std::string location, std::string name, unsigned long taxID = DEFAULT_TAX_ID, float salary = DEFAULT_SALARY,
+    explicit Worker(Location location, std::string name, unsigned long taxID = DEFAULT_TAX_ID, float salary = DEFAULT_SALARY,
                     Credential credential = {DEFAULT_USERNAME, DEFAULT_PASSWORD});
 
+    /**
+     * Creates a new Worker object, interning the name of its location.
+     *
+     * @param location the name of the store delivery location for which the worker has preference
+     * @param name the name
+     * @param salary the salary
+     * @param taxID the taxpayer identification number
+     * @param credential the login credentials
+     */
+    Worker(const std::string& location, std::string name, unsigned long taxID = DEFAULT_TAX_ID,
+           float salary = DEFAULT_SALARY, Credential credential = {DEFAULT_USERNAME, DEFAULT_PASSWORD});
+
     /**
      * Gets the worker salary.
      *
@@ -39,7 +53,19 @@ public:
      */
     unsigned getUndeliveredOrders() const;
 
-    std::string getLocation() const;
+    /**
+     * Gets the store delivery location for which the worker has preference.
+     *
+     * @return the location name
+     */
+    const std::string& getLocation() const;
+
+    /**
+     * Gets the interned store delivery location for which the worker has preference.
+     *
+     * @return the location
+     */
+    const Location& getLocationHandle() const;
 
     /**
      * Sets the worker salary.
@@ -66,18 +92,27 @@ public:
     float getMeanEvaluation() const;
 
     /**
-     * Adds an evaluation to the orders evaluations list.
+     * Adds an order delivered by the worker to its scorecard.
+     *
+     * @param evaluation the client evaluation
+     * @param revenue the final price of the order
+     * @param deliverDate the date the order was delivered
+     */
+    void addDelivery(unsigned evaluation, float revenue, const Date& deliverDate);
+
+    /**
+     * Gets the performance of the worker: delivered orders, revenue and evaluations.
      *
-     * @param evaluation the evaluation
+     * @return the scorecard
      */
-    void addEvaluation (unsigned int evaluation);
+    const WorkerScorecard& getScorecard() const;
 
     /**
      * Prints the worker data.
      *
      * @param os the output stream
      * @param showData if true, prints all data: name, taxpayer identification number, salary, number of undelivered
-     * orders and orders' mean evaluation; otherwise, just prints the name, the taxpayer identification and the and log
+     * orders, orders' mean evaluation, number of delivered orders and mean evaluation over the last days; otherwise, just prints the name, the taxpayer identification and the and log
      * status
      * number and log status
      */
@@ -127,14 +162,14 @@ private:
     float _salary;
 
     /**
-     * The list of evaluations given to each order delivered by the worker.
+     * The performance of the worker.
      */
-    std::vector<unsigned> _evaluations;
+    WorkerScorecard _scorecard;
 
     /**
      * Where the worker does its job.
      */
-    std::string _location;
+    Location _location;
 };
 
 
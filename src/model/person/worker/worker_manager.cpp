@@ -2,8 +2,10 @@
 #include "worker_manager.h"
 #include <utility>
 #include "exception/file_exception.h"
+#include "util/file_reader.h"
 
-WorkerManager::WorkerManager(LocationManager* lm) : _workers(), _locationManager(lm) {
+WorkerManager::WorkerManager(LocationManager* lm) : _workers(), _workersByTaxID(), _workersByUsername(), _addedOrder(), _lastAddedOrder(0),
+        _workersByLoad(), _allWorkersByLoad(), _locationManager(lm), _journal(nullptr) {
 }
 
 bool WorkerManager::has(Worker *worker) const {
@@ -23,20 +25,48 @@ tabHWorker WorkerManager::getAll() {
 Worker* WorkerManager::setSalary(unsigned position, float salary) {
     if(position >= _workers.size()) throw InvalidPersonPosition(position, _workers.size());
     auto it = _workers.begin(); std::advance(it, position);
+    if (_journal){
+        JournalEntry entry(JournalOperation::WORKER_SALARY_CHANGED);
+        entry.writePerson(*it);
+        entry.writeFloat(salary);
+        _journal->record(entry);
+    }
     (*it)->setSalary(salary);
     return *it;
 }
 
 Worker* WorkerManager::add(std::string location, std::string name, unsigned long taxID, float salary, Credential credential) {
     if (!_locationManager->has(location)) throw LocationDoesNotExist(location);
-    auto* worker = new Worker(std::move(location), std::move(name), taxID, salary, std::move(credential));
-    _workers.insert(worker);
+    auto* worker = new Worker(Location(location), std::move(name), taxID, salary, std::move(credential));
+    if (_workers.insert(worker).second){
+        index(worker);
+        _addedOrder[worker] = ++_lastAddedOrder;
+        indexLoad(worker);
+
+        if (_journal){
+            JournalEntry entry(JournalOperation::WORKER_ADDED);
+            entry.writePerson(worker);
+            entry.writeString(worker->getLocation());
+            entry.writeFloat(worker->getSalary());
+            entry.writeString(worker->getCredential().username);
+            entry.writeString(worker->getCredential().password);
+            _journal->record(entry);
+        }
+    }
     return worker;
 }
 
 void WorkerManager::remove(Worker *worker) {
     auto position = _workers.find(worker);
     if(position == _workers.end()) throw PersonDoesNotExist(worker->getName(), worker->getTaxId());
+    if (_journal){
+        JournalEntry entry(JournalOperation::WORKER_REMOVED);
+        entry.writePerson(*position);
+        _journal->record(entry);
+    }
+    unindex(*position);
+    unindexLoad(*position);
+    _addedOrder.erase(*position);
     _workers.erase(position);
 }
 
@@ -44,9 +74,128 @@ void WorkerManager::remove(unsigned long position) {
     if(position >= _workers.size()) throw InvalidPersonPosition(position, _workers.size());
     auto it = _workers.begin();
     std::advance(it, position);
+    if (_journal){
+        JournalEntry entry(JournalOperation::WORKER_REMOVED);
+        entry.writePerson(*it);
+        _journal->record(entry);
+    }
+    unindex(*it);
+    unindexLoad(*it);
+    _addedOrder.erase(*it);
     _workers.erase(it);
 }
 
+void WorkerManager::setTaxID(Worker *worker, unsigned long taxID) {
+    auto position = _workers.find(worker);
+    if (position == _workers.end() || *position != worker)
+        throw PersonDoesNotExist(worker->getName(), worker->getTaxId());
+    if (taxID == worker->getTaxId()) return;
+    if (taxID != Person::DEFAULT_TAX_ID && _workersByTaxID.count(taxID)) throw PersonAlreadyExists(taxID);
+
+    JournalEntry entry(JournalOperation::WORKER_TAX_ID_CHANGED);
+    entry.writePerson(worker);
+    entry.writeUInt64(taxID);
+
+    // workers are identified by their taxpayer identification number, so the worker must be rehashed
+    unsigned long previousTaxID = worker->getTaxId();
+    unindex(worker);
+    _workers.erase(position);
+    worker->setTaxID(taxID);
+    if (!_workers.insert(worker).second){
+        worker->setTaxID(previousTaxID);
+        _workers.insert(worker);
+        index(worker);
+        throw PersonAlreadyExists(taxID);
+    }
+    index(worker);
+    if (_journal) _journal->record(entry);
+}
+
+void WorkerManager::setCredential(Worker *worker, const Credential &credential) {
+    auto position = _workers.find(worker);
+    if (position == _workers.end() || *position != worker)
+        throw PersonDoesNotExist(worker->getName(), worker->getTaxId());
+    if (credential.isReserved()) throw InvalidCredential();
+    if (_journal){
+        JournalEntry entry(JournalOperation::WORKER_CREDENTIAL_CHANGED);
+        entry.writePerson(worker);
+        entry.writeString(credential.username);
+        entry.writeString(credential.password);
+        _journal->record(entry);
+    }
+    unindex(worker);
+    worker->setCredential(credential);
+    index(worker);
+}
+
+void WorkerManager::setName(Worker *worker, const std::string &name) {
+    auto position = _workers.find(worker);
+    if (position == _workers.end() || *position != worker)
+        throw PersonDoesNotExist(worker->getName(), worker->getTaxId());
+    if (name == worker->getName()) return;
+
+    JournalEntry entry(JournalOperation::WORKER_NAME_CHANGED);
+    entry.writePerson(worker);
+    entry.writeString(name);
+
+    // workers with the default taxpayer identification number are hashed by name, so the worker must be rehashed
+    std::string previousName = worker->getName();
+    _workers.erase(position);
+    worker->setName(name);
+    if (!_workers.insert(worker).second){
+        worker->setName(previousName);
+        _workers.insert(worker);
+        throw PersonAlreadyExists(worker->getTaxId());
+    }
+    if (_journal) _journal->record(entry);
+}
+
+void WorkerManager::index(Worker *worker) {
+    if (worker->getTaxId() != Person::DEFAULT_TAX_ID) _workersByTaxID[worker->getTaxId()] = worker;
+    _workersByUsername.emplace(worker->getCredential().username, worker);
+}
+
+void WorkerManager::unindex(Worker *worker) {
+    _workersByTaxID.erase(worker->getTaxId());
+    auto range = _workersByUsername.equal_range(worker->getCredential().username);
+    for (auto it = range.first; it != range.second; ++it){
+        if (it->second == worker) {
+            _workersByUsername.erase(it);
+            break;
+        }
+    }
+}
+
+void WorkerManager::addOrderToDeliver(Worker *worker) {
+    bool indexed = unindexLoad(worker);
+    worker->addOrderToDeliver();
+    if (indexed) indexLoad(worker);
+}
+
+void WorkerManager::removeOrderToDeliver(Worker *worker) {
+    bool indexed = unindexLoad(worker);
+    worker->removeOrderToDeliver();
+    if (indexed) indexLoad(worker);
+}
+
+void WorkerManager::indexLoad(Worker *worker) {
+    const WorkerLoad load = {worker->getUndeliveredOrders(), _addedOrder.at(worker), worker};
+    _workersByLoad[worker->getLocationHandle()].insert(load);
+    _allWorkersByLoad.insert(load);
+}
+
+bool WorkerManager::unindexLoad(Worker *worker) {
+    auto added = _addedOrder.find(worker);
+    if (added == _addedOrder.end()) return false;
+
+    const WorkerLoad load = {worker->getUndeliveredOrders(), added->second, worker};
+    auto locationWorkers = _workersByLoad.find(worker->getLocationHandle());
+    locationWorkers->second.erase(load);
+    if (locationWorkers->second.empty()) _workersByLoad.erase(locationWorkers);
+    _allWorkersByLoad.erase(load);
+    return true;
+}
+
 bool WorkerManager::print(std::ostream &os, bool showData, const std::string& location) {
     if (_workers.empty()){
         os << "No workers yet.\n";
@@ -60,6 +209,8 @@ bool WorkerManager::print(std::ostream &os, bool showData, const std::string& lo
         os << util::column("SALARY")
         << util::column("TO DELIVER")
         << util::column("RATING")
+        << util::column("DELIVERED")
+        << util::column("LAST 30 DAYS")
         << util::column("LOCATION");
     }
     else {
@@ -77,40 +228,55 @@ bool WorkerManager::print(std::ostream &os, bool showData, const std::string& lo
     return true;
 }
 
-Worker* WorkerManager::getLessBusyWorker(const std::string& location) {
+std::vector<Worker*> WorkerManager::getBestWorkers(unsigned long k, const Date& today) const {
+    std::vector<std::pair<float, Worker*>> ranked;
+    ranked.reserve(_workers.size());
+    for (const auto& worker : _workers)
+        ranked.emplace_back(worker->getScorecard().getRecentMeanEvaluation(today), worker);
+
+    k = std::min<unsigned long>(k, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<long>(k), ranked.end(),
+                      [](const std::pair<float, Worker*>& w1, const std::pair<float, Worker*>& w2){
+        if (w1.first != w2.first) return w1.first > w2.first;
+        unsigned long d1 = w1.second->getScorecard().getDeliveries(), d2 = w2.second->getScorecard().getDeliveries();
+        if (d1 != d2) return d1 > d2;
+        return w1.second->getName() < w2.second->getName();
+    });
+
+    std::vector<Worker*> best;
+    best.reserve(k);
+    for (unsigned long i = 0; i < k; ++i) best.push_back(ranked[i].second);
+    return best;
+}
+
+Worker* WorkerManager::getLessBusyWorker(const Location& location) {
     if (_workers.empty()) throw StoreHasNoWorkers();
 
-    auto orderComp = [location](const Worker *worker1, const Worker *worker2) {
-        if (worker1->getLocation() == location && worker2->getLocation() != location){
-            return true;
-        }
-        if (worker1->getLocation() != location && worker2->getLocation() == location){
-            return false;
-        }
-        return worker1->getUndeliveredOrders() < worker2->getUndeliveredOrders();
-    };
-    Worker* lessBusyWorker = *std::min_element(_workers.begin(), _workers.end(), orderComp);
+    auto locationWorkers = _workersByLoad.find(location);
+    const WorkerLoadQueue& workers = locationWorkers != _workersByLoad.end() ?
+            locationWorkers->second : _allWorkersByLoad;
+    Worker* lessBusyWorker = workers.begin()->worker;
     if (lessBusyWorker->getUndeliveredOrders() == Worker::MAX_ORDERS_AT_A_TIME) throw AllWorkersAreBusy();
     return lessBusyWorker;
 }
 
 void WorkerManager::read(const std::string& path) {
-    std::ifstream file(path);
-    if(!file) throw FileNotFound(path);
+    FileReader file(path);
 
     std::string name, location;
     float salary = Worker::DEFAULT_SALARY;
     unsigned long taxID = Person::DEFAULT_TAX_ID;
     Credential credential;
 
-    for(std::string line; getline(file, line); ){
-        util::stripCarriageReturn(line);
-        if (line.empty()) continue;
+    while (file.nextLine()){
+        if (file.isLineEmpty()) continue;
 
-        std::stringstream ss(line);
-        ss >> name >> taxID >> salary >> credential.username >> credential.password >> location;
-        std::replace(name.begin(), name.end(), '-', ' ');
-        std::replace(location.begin(),location.end(),'-',' ');
+        file.read(name, true);
+        file.read(taxID);
+        file.read(salary);
+        file.read(credential.username);
+        file.read(credential.password);
+        file.read(location, true);
         add(location, name, taxID, salary, credential);
     }
 }
@@ -132,31 +298,58 @@ void WorkerManager::write(const std::string &path) {
 }
 
 Worker* WorkerManager::getWorker(unsigned long taxID) const {
+    if (taxID != Person::DEFAULT_TAX_ID){
+        auto indexed = _workersByTaxID.find(taxID);
+        if (indexed != _workersByTaxID.end()) return indexed->second;
+        throw PersonDoesNotExist(taxID);
+    }
+    // several workers may have the default taxpayer identification number
     for(const auto& _worker : _workers){
         if (_worker->getTaxId() == taxID) return _worker;
     }
     throw PersonDoesNotExist(taxID);
 }
 
+std::vector<Worker *> WorkerManager::getByUsername(const std::string &username) const {
+    std::vector<Worker*> res;
+    auto range = _workersByUsername.equal_range(username);
+    for (auto it = range.first; it != range.second; ++it) res.push_back(it->second);
+    return res;
+}
+
 WorkerManager::~WorkerManager() {
     for (auto& w: _workers) delete w;
 }
 
 void WorkerManager::raiseSalary(float percentage) {
+    if (_journal){
+        JournalEntry entry(JournalOperation::SALARIES_RAISED);
+        entry.writeFloat(percentage);
+        _journal->record(entry);
+    }
     for(const auto &worker : _workers){
         worker->setSalary(worker->getSalary()+(worker->getSalary()*percentage/100));
     }
 }
 
 void WorkerManager::decreaseSalary(float percentage) {
+    if (_journal){
+        JournalEntry entry(JournalOperation::SALARIES_DECREASED);
+        entry.writeFloat(percentage);
+        _journal->record(entry);
+    }
     for(const auto &worker : _workers){
         worker->setSalary(worker->getSalary()-(worker->getSalary()*percentage/100));
         if(worker->getSalary()<Worker::MINIMUM_SALARY) worker->setSalary(Worker::MINIMUM_SALARY);
     }
 }
 
-tabHWorker WorkerManager::getByLocation(const std::string &location) {
+void WorkerManager::setJournal(Journal *journal) {
+    _journal = journal;
+}
+
+tabHWorker WorkerManager::getByLocation(const Location &location) {
     tabHWorker res;
-    for (const auto& w : _workers) if (w->getLocation() == location) res.insert(w);
+    for (const auto& w : _workers) if (w->getLocationHandle() == location) res.insert(w);
     return res;
 }
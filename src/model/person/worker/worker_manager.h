@@ -4,27 +4,28 @@
 
 #include "worker.h"
 #include "../../store/location_manager.h"
+#include "../../store/journal.h"
 
 #include <exception/store_exception.h>
 
 #include <algorithm>
 #include <vector>
 #include <fstream>
-#include <unordered_set>
+#include <set>
+#include <unordered_map>
 
 #include "util/util.h"
+#include "util/flat_hash_set.h"
 /**
- * Hash Table where the key is determined by the worker´s name
+ * Hash Table where the key is determined by the worker´s tax ID, or by the name if the worker has the default tax ID
+ * (the same fields that decide if two workers are equal).
  */
 struct WorkerHash
 {
-    int operator() (const Worker* worker) const
+    std::size_t operator() (const Worker* worker) const
     {
-        int hashValue = 0;
-        for (const auto & item: worker->getName()){
-            hashValue = hashValue * 37 + item;
-        }
-        return hashValue;
+        if (worker->getTaxId() != Person::DEFAULT_TAX_ID) return util::hash(std::uint64_t(worker->getTaxId()));
+        return util::hash(worker->getName());
     }
 
     bool operator() (const Worker* worker1, const Worker* worker2) const
@@ -33,7 +34,44 @@ struct WorkerHash
     }
 };
 
-typedef std::unordered_set<Worker*, WorkerHash, WorkerHash> tabHWorker;
+typedef FlatHashSet<Worker*, WorkerHash, WorkerHash> tabHWorker;
+
+/**
+ * Struct relative to the delivery load of a worker, used to find the less busy workers.
+ */
+struct WorkerLoad {
+    /**
+     * The number of undelivered orders of the worker.
+     */
+    unsigned undeliveredOrders;
+
+    /**
+     * The order in which the worker was added to the workers list.
+     */
+    unsigned long addedOrder;
+
+    /**
+     * The worker.
+     */
+    Worker* worker;
+
+    /**
+     * One load is less than other if the worker has less undelivered orders or, if both workers are equally busy,
+     * if the worker was added more recently.
+     *
+     * @param rhs the load to compare with
+     * @return true, if the load is less than rhs; false, otherwise
+     */
+    bool operator<(const WorkerLoad& rhs) const {
+        if (undeliveredOrders != rhs.undeliveredOrders) return undeliveredOrders < rhs.undeliveredOrders;
+        return addedOrder > rhs.addedOrder;
+    }
+};
+
+/**
+ * Workers sorted from the less to the most busy.
+ */
+typedef std::set<WorkerLoad> WorkerLoadQueue;
 
 /**
  * Class that manages the store workers.
@@ -78,7 +116,7 @@ public:
      * @param location the location to search for.
      * @return the filtered unordered set of workers from the requested location
      */
-    tabHWorker getByLocation(const std::string& location);
+    tabHWorker getByLocation(const Location& location);
 
     /**
      * Gets a worker from the workers list by its taxpayer identification number.
@@ -88,6 +126,24 @@ public:
      */
     Worker* getWorker(unsigned long taxID) const;
 
+    /**
+     * Gets the workers whose login username is a certain one.
+     *
+     * @param username the login username
+     * @return the workers with that username
+     */
+    std::vector<Worker*> getByUsername(const std::string& username) const;
+
+    /**
+     * Gets the workers with the best mean client evaluation over the last days, read from their scorecards. Ties are
+     * broken by the number of delivered orders and then by the name.
+     *
+     * @param k the number of workers
+     * @param today the last day of the evaluations
+     * @return up to k workers, from the best to the worst
+     */
+    std::vector<Worker*> getBestWorkers(unsigned long k, const Date& today = Date()) const;
+
     /**
      * Gets the less busy worker which is the worker with less number of undelivered orders,
      * who works at the selected delivery location. If no one works at that location, the less
@@ -96,7 +152,47 @@ public:
      *
      * @return the less busy worker
      */
-    Worker* getLessBusyWorker(const std::string& location);
+    Worker* getLessBusyWorker(const Location& location);
+
+    /**
+     * Assigns one more order to deliver to a worker, keeping the workers sorted by their load.
+     *
+     * @param worker the worker
+     */
+    void addOrderToDeliver(Worker* worker);
+
+    /**
+     * Removes an order to deliver from a worker, keeping the workers sorted by their load.
+     *
+     * @param worker the worker
+     */
+    void removeOrderToDeliver(Worker* worker);
+
+    /**
+     * Sets the taxpayer identification number of a worker on the workers list.
+     *
+     * @param worker the worker
+     * @param taxID the new taxpayer identification number
+     */
+    void setTaxID(Worker* worker, unsigned long taxID);
+
+    /**
+     * Sets the login credentials of a worker on the workers list.
+     *
+     * @param worker the worker
+     * @param credential the new login credentials
+     */
+    void setCredential(Worker* worker, const Credential& credential);
+
+    /**
+     * Sets the name of a worker on the workers list.
+     *
+     * @param worker the worker
+     * @param name the new name
+     * @throws PersonAlreadyExists if the worker has the default taxpayer identification number and another one with
+     * that number already has that name
+     */
+    void setName(Worker* worker, const std::string& name);
 
     /**
      * Sets the salary of the worker at a certain position.
@@ -155,7 +251,8 @@ public:
      *
      * @param os the output stream
      * @param showData if true, prints all data: name, taxpayer identification number, salary, number of undelivered
-     * orders and mean evaluation of the delivered orders; otherwise, just prints the name, the taxpayer
+     * orders, mean evaluation of the delivered orders, number of delivered orders and mean evaluation over the last
+     * days; otherwise, just prints the name, the taxpayer
      * identification number and the log status.
      * @return true, if there are no workers on the list yet; false, otherwise
      */
@@ -175,15 +272,86 @@ public:
      */
     void decreaseSalary(float percentage);
 
+    /**
+     * Sets the journal where the changes to the workers list are recorded.
+     *
+     * @param journal the journal; nullptr, if the changes must not be recorded
+     */
+    void setJournal(Journal* journal);
+
 private:
+    /**
+     * Adds a worker to the load queues.
+     *
+     * @param worker the worker
+     */
+    void indexLoad(Worker* worker);
+
+    /**
+     * Removes a worker from the load queues.
+     *
+     * @param worker the worker
+     * @return true, if the worker was on the load queues; false, otherwise
+     */
+    bool unindexLoad(Worker* worker);
+
+    /**
+     * Adds a worker to the taxpayer identification number and username indexes.
+     *
+     * @param worker the worker
+     */
+    void index(Worker* worker);
+
+    /**
+     * Removes a worker from the taxpayer identification number and username indexes.
+     *
+     * @param worker the worker
+     */
+    void unindex(Worker* worker);
+
     /**
      * The hash table with all the active workers.
      */
     tabHWorker _workers;
+
+    /**
+     * The workers with a taxpayer identification number other than the default one, by that number.
+     */
+    std::unordered_map<unsigned long, Worker*> _workersByTaxID;
+
+    /**
+     * The workers by login username.
+     */
+    std::unordered_multimap<std::string, Worker*> _workersByUsername;
+
+    /**
+     * The order in which each active worker was added to the workers list.
+     */
+    std::unordered_map<const Worker*, unsigned long> _addedOrder;
+
+    /**
+     * The order in which the last worker was added to the workers list.
+     */
+    unsigned long _lastAddedOrder;
+
+    /**
+     * The active workers of each location, sorted by their load.
+     */
+    std::unordered_map<Location, WorkerLoadQueue, LocationHash> _workersByLoad;
+
+    /**
+     * All the active workers, sorted by their load.
+     */
+    WorkerLoadQueue _allWorkersByLoad;
     /**
      * The store location manager.
      */
     LocationManager* _locationManager;
+
+    /**
+     * The journal where the changes are recorded.
+     */
+    Journal* _journal;
 };
 
 
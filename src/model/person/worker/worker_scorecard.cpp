@@ -0,0 +1,61 @@
+#include "worker_scorecard.h"
+
+#include <algorithm>
+
+WorkerScorecard::WorkerScorecard() : _deliveries(0), _revenue(0), _histogram(), _recent() {
+}
+
+void WorkerScorecard::addDelivery(unsigned evaluation, float revenue, const Date &deliverDate) {
+    evaluation = std::min(evaluation, 5u);
+    ++_histogram[evaluation];
+    ++_deliveries;
+    _revenue += revenue;
+
+    const std::int32_t day = deliverDate.getDays(), days = static_cast<std::int32_t>(RECENT_DAYS);
+    DayTotals& slot = _recent[static_cast<std::size_t>((day % days + days) % days)];
+    if (slot.deliveries && slot.day > day) return; // a newer day already took the slot, so this one is not recent
+    if (!slot.deliveries || slot.day < day) slot = {day, 0, 0};
+    ++slot.deliveries;
+    slot.evaluationsSum += evaluation;
+}
+
+unsigned long WorkerScorecard::getDeliveries() const {
+    return _deliveries;
+}
+
+float WorkerScorecard::getRevenue() const {
+    return static_cast<float>(_revenue);
+}
+
+const std::array<unsigned long, 6> &WorkerScorecard::getHistogram() const {
+    return _histogram;
+}
+
+float WorkerScorecard::getMeanEvaluation() const {
+    unsigned long count = 0, sum = 0;
+    for (std::size_t evaluation = 0; evaluation < _histogram.size(); ++evaluation){
+        count += _histogram[evaluation];
+        sum += evaluation * _histogram[evaluation];
+    }
+    return count == 0 ? 0 : static_cast<float>(sum) / static_cast<float>(count);
+}
+
+unsigned long WorkerScorecard::getRecentDeliveries(const Date &today) const {
+    return getRecentTotals(today).deliveries;
+}
+
+float WorkerScorecard::getRecentMeanEvaluation(const Date &today) const {
+    DayTotals totals = getRecentTotals(today);
+    return totals.deliveries == 0 ? 0 : static_cast<float>(totals.evaluationsSum) / static_cast<float>(totals.deliveries);
+}
+
+WorkerScorecard::DayTotals WorkerScorecard::getRecentTotals(const Date &today) const {
+    DayTotals totals{today.getDays(), 0, 0};
+    for (const auto& slot : _recent){
+        if (!slot.deliveries || slot.day > totals.day || totals.day - slot.day >= static_cast<std::int32_t>(RECENT_DAYS))
+            continue;
+        totals.deliveries += slot.deliveries;
+        totals.evaluationsSum += slot.evaluationsSum;
+    }
+    return totals;
+}
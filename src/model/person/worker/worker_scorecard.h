@@ -0,0 +1,118 @@
+#ifndef FEUP_AEDA_PROJECT_WORKER_SCORECARD_H
+#define FEUP_AEDA_PROJECT_WORKER_SCORECARD_H
+
+#include <array>
+#include <cstdint>
+
+#include "model/date/date.h"
+
+/**
+ * Class relative to the performance of a worker: delivered orders, revenue handled and client evaluations, both in
+ * total and over the last days. Every figure is updated as the orders are delivered, on fixed-size state, so reading
+ * it never goes through the orders or the evaluations.
+ */
+class WorkerScorecard {
+public:
+    /**
+     * Creates a new empty WorkerScorecard object.
+     */
+    WorkerScorecard();
+
+    /**
+     * Adds a delivered order.
+     *
+     * @param evaluation the client evaluation, from 0 to 5; greater ones count as 5
+     * @param revenue the final price of the order
+     * @param deliverDate the date the order was delivered
+     */
+    void addDelivery(unsigned evaluation, float revenue, const Date& deliverDate);
+
+    /**
+     * Gets the number of delivered orders.
+     *
+     * @return the number of delivered orders
+     */
+    unsigned long getDeliveries() const;
+
+    /**
+     * Gets the sum of the final prices of the delivered orders.
+     *
+     * @return the revenue
+     */
+    float getRevenue() const;
+
+    /**
+     * Gets the number of client evaluations of each value.
+     *
+     * @return the number of evaluations, indexed by the evaluation
+     */
+    const std::array<unsigned long, 6>& getHistogram() const;
+
+    /**
+     * Gets the mean client evaluation.
+     *
+     * @return the mean evaluation; 0, if there are no evaluations
+     */
+    float getMeanEvaluation() const;
+
+    /**
+     * Gets the number of orders delivered over the last RECENT_DAYS days.
+     *
+     * @param today the last day
+     * @return the number of delivered orders
+     */
+    unsigned long getRecentDeliveries(const Date& today = Date()) const;
+
+    /**
+     * Gets the mean client evaluation of the orders delivered over the last RECENT_DAYS days.
+     *
+     * @param today the last day
+     * @return the mean evaluation; 0, if no order was delivered
+     */
+    float getRecentMeanEvaluation(const Date& today = Date()) const;
+
+    /**
+     * The number of days of the recent figures, today included.
+     */
+    static const unsigned RECENT_DAYS = 30;
+
+private:
+    /**
+     * The delivered orders of a day.
+     */
+    struct DayTotals {
+        std::int32_t day;
+        unsigned long deliveries;
+        unsigned long evaluationsSum;
+    };
+
+    /**
+     * Gets the totals of the deliveries over the last RECENT_DAYS days.
+     *
+     * @param today the last day
+     * @return the totals; its day is the one of today
+     */
+    DayTotals getRecentTotals(const Date& today) const;
+
+    /**
+     * The number of delivered orders.
+     */
+    unsigned long _deliveries;
+
+    /**
+     * The sum of the final prices of the delivered orders.
+     */
+    double _revenue;
+
+    /**
+     * The number of client evaluations of each value.
+     */
+    std::array<unsigned long, 6> _histogram;
+
+    /**
+     * The delivered orders of the last RECENT_DAYS days which had any, each on the slot of its day modulo RECENT_DAYS.
+     */
+    std::array<DayTotals, RECENT_DAYS> _recent;
+};
+
+#endif //FEUP_AEDA_PROJECT_WORKER_SCORECARD_H
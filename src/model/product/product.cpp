@@ -33,7 +33,11 @@ void Product::print(std::ostream& os, bool showInclusions) const {
 }
 
 std::string Bread::getCategory() const {
-    return _small ? "Small Bread" : "Big Bread";
+    return getSizeCategory(_small);
+}
+
+std::string Bread::getSizeCategory(bool small) {
+    return small ? "Small Bread" : "Big Bread";
 }
 
 bool Bread::isSmall() const {
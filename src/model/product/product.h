@@ -127,6 +127,14 @@ public:
 
     bool isSmall() const;
 
+    /**
+     * Gets the category of the breads of a certain size.
+     *
+     * @param small true, if they are small; false, otherwise
+     * @return the bread size as a string
+     */
+    static std::string getSizeCategory(bool small);
+
 private:
     /**
      * The bread size.
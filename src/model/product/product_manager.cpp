@@ -5,9 +5,11 @@
 #include <algorithm>
 
 #include "util/util.h"
+#include "util/file_reader.h"
 #include "exception/file_exception.h"
 
-ProductManager::ProductManager(): _products(ProductEntry()){
+ProductManager::ProductManager(): _products(ProductEntry()), _productsByName(), _productsByCategory(),
+        _journal(nullptr){
 }
 
 bool ProductManager::has(Product *product) const {
@@ -15,17 +17,13 @@ bool ProductManager::has(Product *product) const {
 }
 
 Product* ProductManager::get(unsigned long position) {
-    unsigned count = 0;
-    for (BSTItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
-        if (count == position) return it.retrieve().getProduct();
-        count++;
-    }
-    throw InvalidProductPosition(position, count);
+    if (position >= _products.size()) throw InvalidProductPosition(position, _products.size());
+    return _products.findKth(position).getProduct();
 }
 
 std::vector<Product*> ProductManager::getAll() const {
     std::vector<Product*> res;
-    for (BSTItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
+    for (AVLItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
         res.push_back(it.retrieve().getProduct());
     }
     return res;
@@ -33,32 +31,65 @@ std::vector<Product*> ProductManager::getAll() const {
 
 Bread* ProductManager::addBread(std::string name, float price, bool small) {
     auto it = new Bread(std::move(name),price,small);
-    bool hi = _products.insert(ProductEntry(it));
+    add(it);
     return it;
 }
 
 Cake* ProductManager::addCake(std::string name, float price, CakeCategory category) {
     auto it = new Cake(std::move(name),price,category);
-    _products.insert(ProductEntry(it));
+    add(it);
     return it;
 }
 
 void ProductManager::remove(Product *product) {
     auto p = _products.find(ProductEntry(product));
     if (p.getProduct() == nullptr) throw ProductDoesNotExist(product->getName(),product->getPrice());
+    if (_journal){
+        JournalEntry entry(JournalOperation::PRODUCT_REMOVED);
+        entry.writeProduct(p.getProduct());
+        _journal->record(entry);
+    }
+    unindex(p.getProduct());
     _products.remove(p);
 }
 
+void ProductManager::update(Product *product, unsigned previousInclusions) {
+    if (product->getTimesIncluded() == previousInclusions) return;
+    if (!_products.replace(ProductEntry(product, previousInclusions), ProductEntry(product)))
+        throw ProductDoesNotExist(product->getName(), product->getPrice());
+    _productsByCategory.at(product->getCategory())
+            .replace(ProductEntry(product, previousInclusions), ProductEntry(product));
+}
+
+void ProductManager::update(const std::unordered_map<Product *, unsigned> &previousInclusions) {
+    std::vector<std::pair<ProductEntry, ProductEntry>> changes;
+    std::unordered_map<std::string, std::vector<std::pair<ProductEntry, ProductEntry>>> changesByCategory;
+    for (const auto& p : previousInclusions){
+        if (p.first->getTimesIncluded() == p.second) continue;
+        changes.emplace_back(ProductEntry(p.first, p.second), ProductEntry(p.first));
+        changesByCategory[p.first->getCategory()].push_back(changes.back());
+    }
+    if (changes.empty()) return;
+    if (!_products.replaceAll(changes)){
+        Product* missing = changes.front().first.getProduct();
+        for (const auto& change : changes)
+            if (_products.find(change.first).getProduct() == nullptr) missing = change.first.getProduct();
+        throw ProductDoesNotExist(missing->getName(), missing->getPrice());
+    }
+    for (const auto& category : changesByCategory)
+        _productsByCategory.at(category.first).replaceAll(category.second);
+}
+
 void ProductManager::remove(unsigned long position) {
-    unsigned count = 0;
-    for (BSTItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
-        if (count == position) {
-            _products.remove(it.retrieve());
-            return;
-        }
-        count++;
+    if (position >= _products.size()) throw std::invalid_argument("Product does not exist");
+    const ProductEntry toRemove = _products.findKth(position);
+    if (_journal){
+        JournalEntry entry(JournalOperation::PRODUCT_REMOVED);
+        entry.writeProduct(toRemove.getProduct());
+        _journal->record(entry);
     }
-    throw std::invalid_argument("Product does not exist");
+    unindex(toRemove.getProduct());
+    _products.remove(toRemove);
 }
 
 
@@ -83,50 +114,51 @@ void ProductManager::print(std::ostream &os, bool showInclusions) const {
 }
 
 Product *ProductManager::get(const std::string &name, float price) {
-    for (BSTItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
-        Product* p = it.retrieve().getProduct();
-        if (p->getName() == name && p->getPrice() == price) return p;
+    Product* found = nullptr;
+    auto range = _productsByName.equal_range(name);
+    for (auto it = range.first; it != range.second; ++it){
+        // several products may share the name and price, so keep the first one on the products list
+        if (it->second->getPrice() == price && (!found || ProductEntry(it->second) < ProductEntry(found)))
+            found = it->second;
     }
-    throw ProductDoesNotExist(name, price);
+    if (!found) throw ProductDoesNotExist(name, price);
+    return found;
 }
 
 void ProductManager::read(const std::string &path) {
-    std::ifstream file(path);
-    if(!file) throw FileNotFound(path);
+    FileReader file(path);
 
     bool readingCakes = true;
     std::vector<std::string> cakeCategories = Cake::getCategories();
+    for (auto& category : cakeCategories) std::replace(category.begin(), category.end(), ' ', '-');
 
-    for (std::string line; getline(file, line); ){
-        util::stripCarriageReturn(line);
-        if (line.empty() || line.at(0) == '-') continue;
+    while (file.nextLine()){
+        if (file.isLineEmpty() || file.lineFront() == '-') continue;
 
-        if(line=="CAKES") readingCakes = true;
-        else if(line=="BREADS") readingCakes = false;
+        if(file.isLine("CAKES")) readingCakes = true;
+        else if(file.isLine("BREADS")) readingCakes = false;
         else if(readingCakes) {
-            std::stringstream ss(line);
             std::string name, cakeCategory;
             float price = 1;
 
-            ss >> name >> price >> cakeCategory;
+            file.read(name, true);
+            file.read(price);
+            file.read(cakeCategory);
             CakeCategory categoryToSave = CakeCategory::GENERAL;
             for (unsigned long i = 0; i < cakeCategories.size(); ++i){
-                std::string styledCat = cakeCategories.at(i);
-                std::replace(styledCat.begin(),styledCat.end(),' ','-');
-                if (styledCat == cakeCategory) {
+                if (cakeCategories.at(i) == cakeCategory) {
                     categoryToSave = static_cast<CakeCategory>(i);
                 }
             }
-            std::replace(name.begin(), name.end(), '-', ' ');
             addCake(name, price, categoryToSave);
         }
         else{
-            std::stringstream ss(line);
             std::string name, small;
             float price = 1;
 
-            ss>>name>>price>>small;
-            std::replace(name.begin(), name.end(), '-', ' ');
+            file.read(name, true);
+            file.read(price);
+            file.read(small);
             addBread(name, price, small=="small");
         }
     }
@@ -134,7 +166,7 @@ void ProductManager::read(const std::string &path) {
 
 std::vector<Cake*> ProductManager::getCakes() const {
     std::vector<Cake*> res;
-    for (BSTItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
+    for (AVLItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
         auto cake = dynamic_cast<Cake*>(it.retrieve().getProduct());
         if (cake) res.push_back(cake);
     }
@@ -143,7 +175,7 @@ std::vector<Cake*> ProductManager::getCakes() const {
 
 std::vector<Bread*> ProductManager::getBreads() const {
     std::vector<Bread*> res;
-    for (BSTItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
+    for (AVLItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
         auto bread = dynamic_cast<Bread*>(it.retrieve().getProduct());
         if (bread) res.push_back(bread);
     }
@@ -178,19 +210,51 @@ void ProductManager::write(const std::string &path) const{
 }
 
 ProductManager::~ProductManager() {
-    for (BSTItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
+    for (AVLItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
         delete it.retrieve().getProduct();
     }
 }
 
 Product *ProductManager::add(Product *product) {
-    _products.insert(ProductEntry(product));
+    if (!_products.insert(ProductEntry(product))) return product;
+    _productsByName.emplace(product->getName(), product);
+    _productsByCategory.emplace(std::piecewise_construct, std::forward_as_tuple(product->getCategory()),
+                                std::forward_as_tuple(ProductEntry())).first->second.insert(ProductEntry(product));
+
+    if (_journal){
+        JournalEntry entry(JournalOperation::PRODUCT_ADDED);
+        entry.writeProduct(product);
+        auto cake = dynamic_cast<Cake*>(product);
+        entry.writeUInt8(cake != nullptr);
+        if (cake){
+            std::vector<std::string> categories = Cake::getCategories();
+            auto category = std::find(categories.begin(), categories.end(), cake->getCategory());
+            entry.writeUInt8(static_cast<std::uint8_t>(category - categories.begin()));
+        }
+        else entry.writeUInt8(dynamic_cast<Bread*>(product)->isSmall());
+        _journal->record(entry);
+    }
     return product;
 }
 
+void ProductManager::setJournal(Journal *journal) {
+    _journal = journal;
+}
+
+void ProductManager::unindex(Product *product) {
+    _productsByCategory.at(product->getCategory()).remove(ProductEntry(product));
+    auto range = _productsByName.equal_range(product->getName());
+    for (auto it = range.first; it != range.second; ++it){
+        if (it->second == product) {
+            _productsByName.erase(it);
+            return;
+        }
+    }
+}
+
 std::vector<Product *> ProductManager::getUsed() const {
     std::vector<Product*> res;
-    for (BSTItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
+    for (AVLItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
         if (it.retrieve().getProduct()->getTimesIncluded()) res.push_back(it.retrieve().getProduct());
     }
     return res;
@@ -198,8 +262,42 @@ std::vector<Product *> ProductManager::getUsed() const {
 
 std::vector<Product *> ProductManager::getUnused() const {
     std::vector<Product*> res;
-    for (BSTItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
+    for (AVLItrIn<ProductEntry> it(_products); !it.isAtEnd(); it.advance()){
         if (!it.retrieve().getProduct()->getTimesIncluded()) res.push_back(it.retrieve().getProduct());
     }
     return res;
 }
+
+std::vector<Product *> ProductManager::getBestsellers(unsigned long k) const {
+    return getBestsellers(_products, k);
+}
+
+std::vector<Cake *> ProductManager::getBestCakes(unsigned long k, CakeCategory category) const {
+    std::vector<Cake*> res;
+    for (const auto& product : getBestsellers(k, Cake::categoryStr[static_cast<int>(category)]))
+        res.push_back(static_cast<Cake*>(product));
+    return res;
+}
+
+std::vector<Bread *> ProductManager::getBestBreads(unsigned long k, bool small) const {
+    std::vector<Bread*> res;
+    for (const auto& product : getBestsellers(k, Bread::getSizeCategory(small)))
+        res.push_back(static_cast<Bread*>(product));
+    return res;
+}
+
+std::vector<Product *> ProductManager::getBestsellers(const AVL<ProductEntry> &products, unsigned long k) {
+    // the most included products are at the end of the tree
+    std::vector<Product*> res;
+    for (unsigned long i = products.size(); i > 0 && res.size() < k; --i){
+        Product* product = products.findKth(i - 1).getProduct();
+        if (!product->getTimesIncluded()) break;
+        res.push_back(product);
+    }
+    return res;
+}
+
+std::vector<Product *> ProductManager::getBestsellers(unsigned long k, const std::string &category) const {
+    auto it = _productsByCategory.find(category);
+    return it == _productsByCategory.end() ? std::vector<Product*>() : getBestsellers(it->second, k);
+}
@@ -3,35 +3,51 @@
 #define FEUP_AEDA_PROJECT_PRODUCT_MANAGER_H
 
 #include "product.h"
-#include "util/bst.h"
+#include "util/avl.h"
+#include "model/store/journal.h"
+
+#include <unordered_map>
 
 /**
  * Class that encapsulates a Product* so that operator overloading is possible.
+ * The product inclusions are copied when the entry is created, so that the products tree stays consistent while an
+ * inclusion counter is being updated.
  */
 class ProductEntry {
 public:
     /**
      * Create a new null ProductEntry object.
      */
-    ProductEntry() : _product(nullptr) {};
+    ProductEntry() : _product(nullptr), _timesIncluded(0) {};
     /**
      * Create a new ProductEntry object.
      * @param product the product that shall be encapsulated
      */
-    explicit ProductEntry(Product* product) : _product(product) {};
+    explicit ProductEntry(Product* product) : _product(product), _timesIncluded(product->getTimesIncluded()) {};
+    /**
+     * Create a new ProductEntry object with a previous number of inclusions of the product.
+     * @param product the product that shall be encapsulated
+     * @param timesIncluded the number of inclusions
+     */
+    ProductEntry(Product* product, unsigned timesIncluded) : _product(product), _timesIncluded(timesIncluded) {};
     /**
      * Get the product that the object encapsulates.
      * @return the product pointer
      */
     Product* getProduct() const { return _product; };
     /**
-     * A comparison between two ProductEntry is based on the defined operators for Product.
+     * A comparison between two ProductEntry follows the defined operators for Product, applied to the number of
+     * inclusions when the entries were created.
      * @param rhs the product to be compared to
      * @return the product inequality
      */
     bool operator<(const ProductEntry& rhs) const{
         if (!getProduct() || !rhs.getProduct()) return false;
-        return *getProduct() < *rhs.getProduct();
+        if (_timesIncluded != rhs._timesIncluded) return _timesIncluded < rhs._timesIncluded;
+        if (getProduct()->getCategory() != rhs.getProduct()->getCategory()){
+            return getProduct()->getCategory() < rhs.getProduct()->getCategory();
+        }
+        return getProduct()->getName() < rhs.getProduct()->getName();
     }
     /**
      * A comparison between two ProductEntry is based on the defined operators for Product.
@@ -47,6 +63,11 @@ private:
      * The pointer that the class encapsulates.
      */
     Product* _product;
+
+    /**
+     * The product inclusions when the entry was created.
+     */
+    unsigned _timesIncluded;
 };
 
 /**
@@ -138,6 +159,32 @@ public:
      */
     std::vector<Product*> getUnused() const;
 
+    /**
+     * Gets the products which were included in more orders, from the most to the least included.
+     *
+     * @param k the maximum number of products
+     * @return the up to k most included products; products never included are left out
+     */
+    std::vector<Product*> getBestsellers(unsigned long k) const;
+
+    /**
+     * Gets the cakes of a certain category which were included in more orders, from the most to the least included.
+     *
+     * @param k the maximum number of cakes
+     * @param category the cake category
+     * @return the up to k most included cakes of the category; cakes never included are left out
+     */
+    std::vector<Cake*> getBestCakes(unsigned long k, CakeCategory category) const;
+
+    /**
+     * Gets the breads of a certain size which were included in more orders, from the most to the least included.
+     *
+     * @param k the maximum number of breads
+     * @param small true, for small breads; false, for big breads
+     * @return the up to k most included breads of the size; breads never included are left out
+     */
+    std::vector<Bread*> getBestBreads(unsigned long k, bool small) const;
+
     /**
      * Adds a bread to the product list.
      *
@@ -165,6 +212,24 @@ public:
      */
     Product* add(Product* product);
 
+    /**
+     * Updates the position of a product on the products list after its inclusions changed.
+     * The product is only moved if its position actually changes.
+     *
+     * @param product the product
+     * @param previousInclusions the product inclusions before the change
+     */
+    void update(Product* product, unsigned previousInclusions);
+
+    /**
+     * Updates the position of several products on the products list after their inclusions changed, e.g. when all
+     * the products of an order are included at once. The products list is rebuilt in a single pass when the batch is
+     * large for its size, rather than moving each product on its own.
+     *
+     * @param previousInclusions map of changed products to their inclusions before the change
+     */
+    void update(const std::unordered_map<Product*, unsigned>& previousInclusions);
+
     /**
      * Removes a product from the products list.
      *
@@ -202,11 +267,59 @@ public:
      */
     void print(std::ostream& os, bool showInclusions = true) const;
 
+    /**
+     * Sets the journal where the changes to the products list are recorded.
+     *
+     * @param journal the journal; nullptr, if the changes must not be recorded
+     */
+    void setJournal(Journal* journal);
+
 private:
     /**
-     * The list of all the products.
+     * Removes a product from the name and the category indexes.
+     *
+     * @param product the product
+     */
+    void unindex(Product* product);
+
+    /**
+     * Gets the most included products of a tree.
+     *
+     * @param products the products tree
+     * @param k the maximum number of products
+     * @return the up to k most included products, from the most to the least included
+     */
+    static std::vector<Product*> getBestsellers(const AVL<ProductEntry>& products, unsigned long k);
+
+    /**
+     * Gets the most included products of a category.
+     *
+     * @param k the maximum number of products
+     * @param category the category, as returned by Product::getCategory
+     * @return the up to k most included products of the category, from the most to the least included
+     */
+    std::vector<Product*> getBestsellers(unsigned long k, const std::string& category) const;
+
+    /**
+     * The list of all the products, balanced so that lookups by product or by position are logarithmic.
+     */
+    AVL<ProductEntry> _products;
+
+    /**
+     * The products on the products list, by name.
+     */
+    std::unordered_multimap<std::string, Product*> _productsByName;
+
+    /**
+     * The products on the products list, by category, sorted like the products list so that the most included ones
+     * of each category are found without going through the others.
+     */
+    std::unordered_map<std::string, AVL<ProductEntry>> _productsByCategory;
+
+    /**
+     * The journal where the changes are recorded.
      */
-    BST<ProductEntry> _products;
+    Journal* _journal;
 };
 
 #endif //FEUP_AEDA_PROJECT_PRODUCT_MANAGER_H
@@ -0,0 +1,171 @@
+#include "journal.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "model/order/order.h"
+#include "model/person/client/client.h"
+#include "model/person/worker/worker.h"
+#include "exception/file_exception.h"
+#include "util/util.h"
+
+namespace {
+    /**
+     * The 4 characters which identify a journal file.
+     */
+    const char* JOURNAL_MAGIC = "BKJL";
+
+    /**
+     * The current version of the journal format.
+     */
+    const std::uint32_t JOURNAL_VERSION = 1;
+
+    /**
+     * The size of the journal header: magic, version and generation.
+     */
+    const std::size_t HEADER_SIZE = 4 + 4 + 8;
+
+    /**
+     * The size of the data saved before each entry: its size and checksum.
+     */
+    const std::size_t ENTRY_HEADER_SIZE = 4 + 8;
+}
+
+const unsigned Journal::DEFAULT_GROUP_SIZE = 32;
+
+JournalEntry::JournalEntry(JournalOperation operation) : BinaryWriter() {
+    writeUInt8(static_cast<std::uint8_t>(operation));
+}
+
+void JournalEntry::writePerson(const Person *person) {
+    writeUInt64(person->getTaxId());
+    writeString(person->getName());
+}
+
+void JournalEntry::writeProduct(const Product *product) {
+    writeString(product->getName());
+    writeFloat(product->getPrice());
+}
+
+void JournalEntry::writeDate(const Date &date) {
+    writeUInt16(static_cast<std::uint16_t>(date.getYear()));
+    writeUInt8(static_cast<std::uint8_t>(date.getMonth()));
+    writeUInt8(static_cast<std::uint8_t>(date.getDay()));
+    writeUInt8(static_cast<std::uint8_t>(date.getHour()));
+    writeUInt8(static_cast<std::uint8_t>(date.getMinute()));
+}
+
+void JournalEntry::writeOrder(const Order *order) {
+    writePerson(order->getClient());
+    writePerson(order->getWorker());
+    writeString(order->getDeliverLocation());
+    writeDate(order->getRequestDate());
+}
+
+Journal::Journal(std::string path, std::uint64_t generation, unsigned groupSize) :
+        _path(std::move(path)), _file(nullptr), _pending(), _pendingEntries(0), _groupSize(groupSize ? groupSize : 1) {
+    open(generation);
+}
+
+Journal::~Journal() {
+    if (!_file) return;
+    sync();
+    std::fclose(_file);
+}
+
+void Journal::open(std::uint64_t generation) {
+    _file = std::fopen(_path.c_str(), "wb");
+    if (!_file) throw FileNotFound(_path);
+
+    BinaryWriter header;
+    header.writeUInt32(JOURNAL_VERSION);
+    header.writeUInt64(generation);
+    std::fwrite(JOURNAL_MAGIC, 1, 4, _file);
+    std::fwrite(header.getData().data(), 1, header.getData().size(), _file);
+    std::fflush(_file);
+#ifdef _WIN32
+    _commit(_fileno(_file));
+#else
+    fsync(fileno(_file));
+#endif
+}
+
+void Journal::record(const JournalEntry &entry) {
+    const std::vector<char>& payload = entry.getData();
+    BinaryWriter frame;
+    frame.writeUInt32(static_cast<std::uint32_t>(payload.size()));
+    frame.writeUInt64(util::hash(payload.data(), payload.size()));
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pending.insert(_pending.end(), frame.getData().begin(), frame.getData().end());
+    _pending.insert(_pending.end(), payload.begin(), payload.end());
+
+    if (++_pendingEntries >= _groupSize) commit();
+}
+
+void Journal::sync() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    commit();
+}
+
+void Journal::commit() {
+    if (_pending.empty() || !_file) return;
+    std::fwrite(_pending.data(), 1, _pending.size(), _file);
+    std::fflush(_file);
+#ifdef _WIN32
+    _commit(_fileno(_file));
+#else
+    fsync(fileno(_file));
+#endif
+    _pending.clear();
+    _pendingEntries = 0;
+}
+
+void Journal::restart(std::uint64_t generation) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pending.clear();
+    _pendingEntries = 0;
+    std::fclose(_file);
+    _file = nullptr;
+    open(generation);
+}
+
+unsigned Journal::getPendingEntries() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pendingEntries;
+}
+
+std::vector<BinaryReader> Journal::read(const std::string &path, std::uint64_t generation) {
+    std::vector<BinaryReader> entries;
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return entries;
+
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.empty()) return entries;
+    if (data.size() < HEADER_SIZE || std::memcmp(data.data(), JOURNAL_MAGIC, 4) != 0) throw InvalidFile(path);
+    BinaryReader header(std::vector<char>(data.begin() + 4, data.begin() + HEADER_SIZE), path);
+    if (header.readUInt32() != JOURNAL_VERSION) throw InvalidFile(path);
+    if (header.readUInt64() != generation) return entries;
+
+    // an incomplete or corrupted entry can only be the last one, which was being written when the application stopped
+    for (std::size_t position = HEADER_SIZE; data.size() - position >= ENTRY_HEADER_SIZE; ){
+        auto entryBegin = data.begin() + static_cast<std::ptrdiff_t>(position);
+        BinaryReader entryHeader(std::vector<char>(entryBegin, entryBegin + ENTRY_HEADER_SIZE), path);
+        std::uint32_t size = entryHeader.readUInt32();
+        std::uint64_t checksum = entryHeader.readUInt64();
+        if (size > data.size() - position - ENTRY_HEADER_SIZE) break;
+
+        std::vector<char> payload(entryBegin + ENTRY_HEADER_SIZE, entryBegin + ENTRY_HEADER_SIZE + size);
+        if (util::hash(payload.data(), payload.size()) != checksum) break;
+        entries.emplace_back(std::move(payload), path);
+        position += ENTRY_HEADER_SIZE + size;
+    }
+    return entries;
+}
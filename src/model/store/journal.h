@@ -0,0 +1,167 @@
+#ifndef FEUP_AEDA_PROJECT_JOURNAL_H
+#define FEUP_AEDA_PROJECT_JOURNAL_H
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "util/binary_file.h"
+
+class Person;
+class Product;
+class Order;
+class Date;
+
+/**
+ * The operations which are recorded on a journal.
+ */
+enum class JournalOperation : std::uint8_t {
+    LOCATION_ADDED, LOCATION_REMOVED,
+    PRODUCT_ADDED, PRODUCT_REMOVED,
+    CLIENT_ADDED, CLIENT_REMOVED, CLIENT_TAX_ID_CHANGED, CLIENT_CREDENTIAL_CHANGED,
+    WORKER_ADDED, WORKER_REMOVED, WORKER_TAX_ID_CHANGED, WORKER_CREDENTIAL_CHANGED, WORKER_SALARY_CHANGED,
+    SALARIES_RAISED, SALARIES_DECREASED,
+    ORDER_ADDED, ORDER_REMOVED, ORDER_PRODUCT_ADDED, ORDER_PRODUCT_REMOVED, ORDER_LOCATION_CHANGED, ORDER_DELIVERED,
+    ORDER_ARCHIVED,
+    CLIENT_NAME_CHANGED, CLIENT_PREMIUM_CHANGED, WORKER_NAME_CHANGED,
+    BOSS_CHANGED
+};
+
+/**
+ * Class relative to a journal entry: the operation, followed by its arguments.
+ * People are referenced by their taxpayer identification number and name, products by their name and price, and
+ * orders by their client, worker, location and request date, since these are kept across snapshots.
+ */
+class JournalEntry : public BinaryWriter {
+public:
+    /**
+     * Creates a new JournalEntry object.
+     *
+     * @param operation the operation
+     */
+    explicit JournalEntry(JournalOperation operation);
+
+    void writePerson(const Person* person);
+    void writeProduct(const Product* product);
+    void writeDate(const Date& date);
+    void writeOrder(const Order* order);
+};
+
+/**
+ * Class relative to an append-only journal of the operations done on the store since the last snapshot.
+ * Entries are committed in groups: they are kept in memory and written and flushed to the disk once there are enough
+ * of them, or when sync() is called. Each entry is saved with its size and checksum, so that an entry which was only
+ * partially written when the application stopped is detected and ignored.
+ * Entries can be recorded by several threads at once, e.g. while the managers are read in parallel.
+ */
+class Journal {
+public:
+    /**
+     * Creates a new Journal object, starting an empty journal file.
+     *
+     * @param path the file path
+     * @param generation the generation of the journal, which must match the one saved on the snapshot it follows
+     * @param groupSize the number of entries which are committed at once
+     * @throws FileNotFound if the file can't be opened
+     */
+    Journal(std::string path, std::uint64_t generation, unsigned groupSize = DEFAULT_GROUP_SIZE);
+
+    /**
+     * Destructs the Journal object, committing the entries which are still in memory.
+     */
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    /**
+     * Records an entry, committing the group if it is complete.
+     *
+     * @param entry the entry
+     */
+    void record(const JournalEntry& entry);
+
+    /**
+     * Writes the entries which are still in memory and flushes them to the disk.
+     */
+    void sync();
+
+    /**
+     * Erases all the entries, after they were saved on a snapshot, and starts a new generation. The snapshot must
+     * already be on the disk, as the previous entries are lost.
+     *
+     * @param generation the new generation
+     */
+    void restart(std::uint64_t generation);
+
+    /**
+     * Gets the number of entries which were recorded but not committed yet.
+     *
+     * @return the number of entries
+     */
+    unsigned getPendingEntries() const;
+
+    /**
+     * Reads all the valid entries of a journal file, stopping at the first one which is incomplete or corrupted.
+     * A journal of another generation was already saved on a snapshot (or came before it), so it is ignored.
+     *
+     * @param path the file path
+     * @param generation the generation of the snapshot the journal must follow
+     * @return the list of entries; empty, if the file doesn't exist or is of another generation
+     * @throws InvalidFile if the file isn't a journal
+     */
+    static std::vector<BinaryReader> read(const std::string& path, std::uint64_t generation);
+
+    /**
+     * The default number of entries which are committed at once.
+     */
+    static const unsigned DEFAULT_GROUP_SIZE;
+
+private:
+    /**
+     * Opens the journal file, erasing its previous contents, and writes the header.
+     *
+     * @param generation the generation of the journal
+     * @throws FileNotFound if the file can't be opened
+     */
+    void open(std::uint64_t generation);
+
+    /**
+     * Writes the pending entries and flushes them to the disk. The mutex must be held by the caller.
+     */
+    void commit();
+
+    /**
+     * The path of the journal file.
+     */
+    std::string _path;
+
+    /**
+     * The journal file.
+     */
+    std::FILE* _file;
+
+    /**
+     * The entries which were not committed yet, already framed.
+     */
+    std::vector<char> _pending;
+
+    /**
+     * The number of entries which were not committed yet.
+     */
+    unsigned _pendingEntries;
+
+    /**
+     * The number of entries which are committed at once.
+     */
+    unsigned _groupSize;
+
+    /**
+     * The mutex which guards the pending entries and the file.
+     */
+    mutable std::mutex _mutex;
+};
+
+#endif //FEUP_AEDA_PROJECT_JOURNAL_H
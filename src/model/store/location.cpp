@@ -0,0 +1,67 @@
+#include "location.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+struct Location::Pool {
+    std::mutex mutex;
+    std::deque<Entry> entries;
+    std::unordered_map<std::string, Location> byName;
+};
+
+Location::Location(const std::string &name) : _entry(intern(name)) {
+}
+
+Location::Location(const char *name) : _entry(intern(name)) {
+}
+
+Location::Location(const Entry *entry) : _entry(entry) {
+}
+
+const Location *Location::find(const std::string &name) {
+    Pool& pool = getPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    auto interned = pool.byName.find(name);
+    return interned != pool.byName.end() ? &interned->second : nullptr;
+}
+
+Location::Pool &Location::getPool() {
+    static Pool pool;
+    return pool;
+}
+
+const Location::Entry *Location::intern(const std::string &name) {
+    Pool& pool = getPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    auto interned = pool.byName.find(name);
+    if (interned != pool.byName.end()) return interned->second._entry;
+
+    pool.entries.push_back(Entry{name, static_cast<unsigned>(pool.entries.size())});
+    pool.byName.emplace(name, Location(&pool.entries.back()));
+    return &pool.entries.back();
+}
+
+const std::string &Location::getName() const {
+    return _entry->name;
+}
+
+unsigned Location::getId() const {
+    return _entry->id;
+}
+
+Location::operator const std::string &() const {
+    return _entry->name;
+}
+
+bool Location::operator==(const Location &rhs) const {
+    return _entry == rhs._entry;
+}
+
+bool Location::operator!=(const Location &rhs) const {
+    return _entry != rhs._entry;
+}
+
+std::ostream &operator<<(std::ostream &os, const Location &location) {
+    return os << location.getName();
+}
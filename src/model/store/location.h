@@ -0,0 +1,136 @@
+#ifndef FEUP_AEDA_PROJECT_LOCATION_H
+#define FEUP_AEDA_PROJECT_LOCATION_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+/**
+ * Class relative to an interned location name. Each distinct name is saved only once, for the whole application, and
+ * every Location with that name refers to it, so that locations take the size of a pointer, are compared with a single
+ * integer comparison and are hashed by their identifier.
+ * Interned names are never freed, so only names of actual store locations should be interned; names which are only
+ * looked up go through find().
+ */
+class Location {
+public:
+    /**
+     * Creates a new Location object, interning the name if it wasn't interned yet.
+     *
+     * @param name the name
+     */
+    explicit Location(const std::string& name);
+
+    /**
+     * Creates a new Location object, interning the name if it wasn't interned yet.
+     *
+     * @param name the name
+     */
+    explicit Location(const char* name);
+
+    /**
+     * Finds the location with a certain name, without interning it.
+     *
+     * @param name the name
+     * @return the location; nullptr, if the name was never interned, in which case nothing refers to it
+     */
+    static const Location* find(const std::string& name);
+
+    /**
+     * Gets the name.
+     *
+     * @return the name
+     */
+    const std::string& getName() const;
+
+    /**
+     * Gets the identifier, which is unique for each name and small, since the names are numbered as they are interned.
+     *
+     * @return the identifier
+     */
+    unsigned getId() const;
+
+    /**
+     * Converts the location to its name.
+     *
+     * @return the name
+     */
+    operator const std::string&() const;
+
+    /**
+     * Two locations are equal if they have the same name.
+     *
+     * @param rhs the location to compare with
+     * @return true, if the locations are equal; false, otherwise
+     */
+    bool operator==(const Location& rhs) const;
+
+    /**
+     * Two locations are different if they have different names.
+     *
+     * @param rhs the location to compare with
+     * @return true, if the locations are different; false, otherwise
+     */
+    bool operator!=(const Location& rhs) const;
+
+private:
+    /**
+     * An interned name.
+     */
+    struct Entry {
+        std::string name;
+        unsigned id;
+    };
+
+    /**
+     * The interned names, which are never moved nor erased, so that they can be read without locking.
+     */
+    struct Pool;
+
+    /**
+     * Gets the interned names of the application.
+     *
+     * @return the interned names
+     */
+    static Pool& getPool();
+
+    /**
+     * Creates a new Location object for an interned name.
+     *
+     * @param entry the interned name
+     */
+    explicit Location(const Entry* entry);
+
+    /**
+     * Gets the interned name, interning it if needed.
+     *
+     * @param name the name
+     * @return the interned name
+     */
+    static const Entry* intern(const std::string& name);
+
+    /**
+     * The interned name.
+     */
+    const Entry* _entry;
+};
+
+/**
+ * Struct to hash locations by their identifier.
+ */
+struct LocationHash {
+    std::size_t operator()(const Location& location) const {
+        return location.getId();
+    }
+};
+
+/**
+ * Prints the name of a location.
+ *
+ * @param os the output stream
+ * @param location the location
+ * @return the output stream
+ */
+std::ostream& operator<<(std::ostream& os, const Location& location);
+
+#endif //FEUP_AEDA_PROJECT_LOCATION_H
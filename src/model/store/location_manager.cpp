@@ -1,33 +1,40 @@
 #include "location_manager.h"
 #include "exception/file_exception.h"
+#include "util/file_reader.h"
 
-LocationManager::LocationManager() : _locations(){
+LocationManager::LocationManager() : _locations(), _journal(nullptr){
     _locations.insert(Order::DEFAULT_LOCATION);
 }
 
 bool LocationManager::has(const std::string& location) {
-    return std::find(_locations.begin(), _locations.end(), location) != _locations.end();
+    return _locations.count(location) != 0;
 }
 
 void LocationManager::add(const std::string& location) {
-    _locations.insert(location);
+    if (_locations.insert(location).second && _journal){
+        JournalEntry entry(JournalOperation::LOCATION_ADDED);
+        entry.writeString(location);
+        _journal->record(entry);
+    }
 }
 
 void LocationManager::remove(const std::string& location) {
     if (location == Order::DEFAULT_LOCATION) throw std::logic_error("You cannot remove the Head Office.");
     if (!has(location)) throw LocationDoesNotExist(location);
-    _locations.erase(std::find(_locations.begin(), _locations.end(), location));
+    if (_journal){
+        JournalEntry entry(JournalOperation::LOCATION_REMOVED);
+        entry.writeString(location);
+        _journal->record(entry);
+    }
+    _locations.erase(location);
 }
 
 void LocationManager::read(const std::string& path) {
-    std::ifstream file(path);
-    if (!file) throw FileNotFound(path);
+    FileReader file(path);
 
-    for (std::string line; std::getline(file,line);){
-        util::stripCarriageReturn(line);
-        if (line.empty()) continue;
-        std::replace(line.begin(),line.end(),'-',' ');
-        add(line);
+    while (file.nextLine()){
+        if (file.isLineEmpty()) continue;
+        add(file.line(true));
     }
 }
 
@@ -42,6 +49,10 @@ void LocationManager::write(const std::string &path) {
     }
 }
 
+void LocationManager::setJournal(Journal *journal) {
+    _journal = journal;
+}
+
 std::set<std::string> LocationManager::getAll() {
     return _locations;
 }
@@ -51,5 +62,10 @@ void LocationManager::remove(unsigned long index) {
     auto it = _locations.begin();
     std::advance(it,index);
     if (*it == Order::DEFAULT_LOCATION) throw std::logic_error("You cannot remove the Head Office.");
-    else _locations.erase(it);
+    if (_journal){
+        JournalEntry entry(JournalOperation::LOCATION_REMOVED);
+        entry.writeString(*it);
+        _journal->record(entry);
+    }
+    _locations.erase(it);
 }
\ No newline at end of file
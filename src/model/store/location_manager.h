@@ -2,6 +2,7 @@
 #define FEUP_AEDA_PROJECT_LOCATION_MANAGER_H
 
 #include "model/order/order.h"
+#include "journal.h"
 
 /**
  * Class that manages the store locations.
@@ -64,11 +65,23 @@ public:
      */
     void write(const std::string &path);
 
+    /**
+     * Sets the journal where the changes to the locations list are recorded.
+     *
+     * @param journal the journal; nullptr, if the changes must not be recorded
+     */
+    void setJournal(Journal* journal);
+
 private:
     /**
      * The list of all store locations available.
      */
     std::set<std::string> _locations;
+
+    /**
+     * The journal where the changes are recorded.
+     */
+    Journal* _journal;
 };
 
 #endif //FEUP_AEDA_PROJECT_LOCATION_MANAGER_H
@@ -1,7 +1,20 @@
 
 #include "store.h"
 
-#include <numeric>
+#include <fstream>
+#include <unordered_map>
+
+#include "util/binary_file.h"
+#include "util/util.h"
+#include "exception/file_exception.h"
+#include "exception/person_exception.h"
+
+const char* Store::SNAPSHOT_MAGIC = "BKSS";
+const std::uint32_t Store::SNAPSHOT_VERSION = 4;
+const std::uint8_t Store::UNDELIVERED_EVALUATION = 0xff;
+const char* Store::DEFAULT_SNAPSHOT_PATH = "store.snapshot";
+const char* Store::DEFAULT_JOURNAL_PATH = "store.journal";
+const char* Store::DEFAULT_ARCHIVE_PATH = "store.archive";
 
 Store::Store(std::string name) :
         _name(std::move(name)),
@@ -10,7 +23,10 @@ Store::Store(std::string name) :
         clientManager(),
         workerManager(&locationManager),
         orderManager(&productManager,&clientManager,&workerManager,&locationManager),
-        boss("Boss", Person::DEFAULT_TAX_ID, {Boss::DEFAULT_USERNAME,Boss::DEFAULT_PASSWORD})
+        boss("Boss", Person::DEFAULT_TAX_ID, {Boss::DEFAULT_USERNAME,Boss::DEFAULT_PASSWORD}),
+        _snapshotPath(),
+        _journalGeneration(0),
+        _journal()
         {}
 
 std::string Store::getName() const {
@@ -18,18 +34,9 @@ std::string Store::getName() const {
 }
 
 int Store::getEvaluation() const {
-    std::vector<int> evaluations;
-    int count = 0;
-    std::priority_queue<OrderEntry> orders = orderManager.getAll();
-    while(!orders.empty()){
-        const auto& order = orders.top().getOrder();
-        orders.pop();
-        if(order->wasDelivered()){
-            evaluations.push_back(order->getClientEvaluation());
-            count++;
-        }
-    }
-    return count ? std::accumulate(evaluations.begin(),evaluations.end(),0) / count : 0;
+    unsigned long count = orderManager.getArchive().getSize() + orderManager.getDeliveredCount();
+    unsigned long sum = orderManager.getArchive().getEvaluationsSum() + orderManager.getEvaluationsSum();
+    return count ? static_cast<int>(sum / count) : 0;
 }
 
 void Store::setName(const std::string& name) {
@@ -37,24 +44,20 @@ void Store::setName(const std::string& name) {
 }
 
 float Store::getProfit() const {
-    float profit = 0.0f;
-    std::priority_queue<OrderEntry> orders = orderManager.getAll();
-    while(!orders.empty()){
-        const auto& order = orders.top().getOrder();
-        orders.pop();
-        if(order->wasDelivered()) profit += order->getFinalPrice();
-    }
-    return profit;
+    return orderManager.getArchive().getProfit() + orderManager.getRevenue();
 }
 
-std::string Store::read(const std::string &dataFolderPath) {
+std::string Store::read(const std::string &dataFolderPath, unsigned threads) {
     try {
-        boss.read(dataFolderPath + "/boss.txt");
-        locationManager.read(dataFolderPath + "/locations.txt");
-        productManager.read(dataFolderPath + "/products.txt");
-        clientManager.read(dataFolderPath + "/clients.txt");
+        util::runInParallel({
+            [&]() { boss.read(dataFolderPath + "/boss.txt"); },
+            [&]() { locationManager.read(dataFolderPath + "/locations.txt"); },
+            [&]() { productManager.read(dataFolderPath + "/products.txt"); },
+            [&]() { clientManager.read(dataFolderPath + "/clients.txt"); }
+        }, threads);
+        // workers need the locations, and orders need everything else
         workerManager.read(dataFolderPath + "/workers.txt");
-        orderManager.read(dataFolderPath + "/orders.txt");
+        orderManager.read(dataFolderPath + "/orders.txt", threads);
     }
     catch (std::exception& e){
         return "Import failed!\n" + std::string(e.what());
@@ -76,3 +79,474 @@ std::string Store::write(const std::string& dataFolderPath) {
     }
     return "Export succeeded.";
 }
+
+std::string Store::readSnapshot(const std::string &path) {
+    try {
+        loadSnapshot(path);
+    }
+    catch (std::exception& e){
+        return "Import failed!\n" + std::string(e.what());
+    }
+    return "Import succeeded.";
+}
+
+std::string Store::writeSnapshot(const std::string &path) {
+    try {
+        saveSnapshot(path);
+    }
+    catch (std::exception& e){
+        return "Export failed!\n" + std::string(e.what());
+    }
+    return "Export succeeded.";
+}
+
+void Store::loadSnapshot(const std::string &path) {
+    BinaryReader file(path, SNAPSHOT_MAGIC, SNAPSHOT_VERSION);
+    auto check = [&](bool valid) { if (!valid) throw InvalidFile(path); };
+
+    std::vector<std::string> strings(file.readUInt32());
+    for (auto& str : strings) str = file.readString();
+    auto readString = [&]() -> const std::string& {
+        std::uint32_t id = file.readUInt32();
+        check(id < strings.size());
+        return strings[id];
+    };
+
+    std::uint64_t journalGeneration = file.readUInt64();
+    std::string bossName = readString();
+    unsigned long bossTaxID = file.readUInt64();
+    std::string bossUsername = readString();
+    boss.setName(bossName);
+    boss.setTaxID(bossTaxID);
+    boss.setCredential({bossUsername, readString()});
+
+    for (std::uint32_t i = 0, count = file.readUInt32(); i < count; ++i) locationManager.add(readString());
+
+    std::vector<Product*> products(file.readUInt32());
+    for (auto& product : products){
+        std::string name = readString();
+        float price = file.readFloat();
+        bool isCake = file.readUInt8();
+        std::uint8_t variant = file.readUInt8();
+        check(!isCake || variant < Cake::getCategories().size());
+        if (isCake) product = productManager.addCake(name, price, static_cast<CakeCategory>(variant));
+        else product = productManager.addBread(name, price, variant);
+    }
+
+    std::vector<Client*> clients(file.readUInt32());
+    for (auto& client : clients){
+        std::string name = readString();
+        unsigned long taxID = file.readUInt64();
+        bool premium = file.readUInt8();
+        unsigned points = file.readUInt32();
+        std::string username = readString();
+        client = clientManager.add(name, taxID, premium, {username, readString()});
+        client->setPoints(points);
+    }
+
+    std::vector<Worker*> workers(file.readUInt32());
+    for (auto& worker : workers){
+        std::string name = readString();
+        unsigned long taxID = file.readUInt64();
+        float salary = file.readFloat();
+        std::string username = readString();
+        std::string password = readString();
+        worker = workerManager.add(readString(), name, taxID, salary, {username, password});
+    }
+
+    // orders are saved column by column
+    std::uint32_t numOrders = file.readUInt32();
+    std::vector<std::uint32_t> orderClients(numOrders), orderWorkers(numOrders), orderLocations(numOrders);
+    std::vector<std::uint32_t> orderNumProducts(numOrders);
+    std::vector<std::uint16_t> years(numOrders);
+    std::vector<std::uint8_t> months(numOrders), days(numOrders), hours(numOrders), minutes(numOrders);
+    std::vector<std::uint8_t> evaluations(numOrders);
+    std::vector<std::int32_t> deliverDurations(numOrders);
+    for (auto& client : orderClients) { client = file.readUInt32(); check(client < clients.size()); }
+    for (auto& worker : orderWorkers) { worker = file.readUInt32(); check(worker < workers.size()); }
+    for (auto& location : orderLocations) { location = file.readUInt32(); check(location < strings.size()); }
+    for (auto& year : years) year = file.readUInt16();
+    for (auto& month : months) month = file.readUInt8();
+    for (auto& day : days) day = file.readUInt8();
+    for (auto& hour : hours) hour = file.readUInt8();
+    for (auto& minute : minutes) minute = file.readUInt8();
+    for (auto& evaluation : evaluations) evaluation = file.readUInt8();
+    for (auto& duration : deliverDurations) duration = static_cast<std::int32_t>(file.readUInt32());
+    for (auto& numProducts : orderNumProducts) numProducts = file.readUInt32();
+
+    std::uint32_t totalProducts = file.readUInt32();
+    std::vector<std::uint32_t> orderProducts(totalProducts), quantities(totalProducts);
+    for (auto& product : orderProducts) { product = file.readUInt32(); check(product < products.size()); }
+    for (auto& quantity : quantities) quantity = file.readUInt32();
+
+    for (std::uint32_t i = 0, productPosition = 0; i < numOrders; ++i){
+        Order* order = orderManager.add(clients[orderClients[i]], workers[orderWorkers[i]],
+                                        strings[orderLocations[i]],
+                                        Date(days[i], months[i], years[i], hours[i], minutes[i]));
+        for (std::uint32_t j = 0; j < orderNumProducts[i]; ++j, ++productPosition){
+            check(productPosition < totalProducts);
+            orderManager.addProduct(order, products[orderProducts[productPosition]], quantities[productPosition]);
+        }
+        // client points are kept with the clients, so do not change them
+        if (evaluations[i] != UNDELIVERED_EVALUATION)
+            orderManager.deliver(order, evaluations[i], false, deliverDurations[i]);
+    }
+
+    // the sketches also hold archived orders, so the ones saved replace the ones of the orders added back
+    orderManager.readSketches(file, workers);
+    check(file.isAtEnd());
+    _journalGeneration = journalGeneration;
+}
+
+void Store::saveSnapshot(const std::string &path) {
+    BinaryWriter records;
+    std::vector<const std::string*> strings;
+    std::unordered_map<std::string, std::uint32_t> stringIds;
+    auto writeString = [&](const std::string& str) {
+        auto inserted = stringIds.emplace(str, static_cast<std::uint32_t>(strings.size()));
+        if (inserted.second) strings.push_back(&inserted.first->first);
+        records.writeUInt32(inserted.first->second);
+    };
+
+    records.writeUInt64(_journalGeneration);
+    writeString(boss.getName());
+    records.writeUInt64(boss.getTaxId());
+    writeString(boss.getCredential().username);
+    writeString(boss.getCredential().password);
+
+    std::set<std::string> locations = locationManager.getAll();
+    records.writeUInt32(static_cast<std::uint32_t>(locations.size()));
+    for (const auto& location : locations) writeString(location);
+
+    std::vector<Product*> products = productManager.getAll();
+    std::unordered_map<const Product*, std::uint32_t> productIds;
+    records.writeUInt32(static_cast<std::uint32_t>(products.size()));
+    for (const auto& product : products){
+        productIds.emplace(product, static_cast<std::uint32_t>(productIds.size()));
+        writeString(product->getName());
+        records.writeFloat(product->getPrice());
+        auto cake = dynamic_cast<const Cake*>(product);
+        records.writeUInt8(cake != nullptr);
+        if (cake){
+            std::vector<std::string> categories = Cake::getCategories();
+            auto category = std::find(categories.begin(), categories.end(), cake->getCategory());
+            records.writeUInt8(static_cast<std::uint8_t>(category - categories.begin()));
+        }
+        else records.writeUInt8(dynamic_cast<const Bread*>(product)->isSmall());
+    }
+
+    std::set<Client*, PersonSmaller> clients = clientManager.getAll();
+    std::unordered_map<const Client*, std::uint32_t> clientIds;
+    records.writeUInt32(static_cast<std::uint32_t>(clients.size()));
+    for (const auto& client : clients){
+        clientIds.emplace(client, static_cast<std::uint32_t>(clientIds.size()));
+        writeString(client->getName());
+        records.writeUInt64(client->getTaxId());
+        records.writeUInt8(client->isPremium());
+        records.writeUInt32(client->getPoints());
+        writeString(client->getCredential().username);
+        writeString(client->getCredential().password);
+    }
+
+    tabHWorker workers = workerManager.getAll();
+    std::unordered_map<const Worker*, std::uint32_t> workerIds;
+    records.writeUInt32(static_cast<std::uint32_t>(workers.size()));
+    for (const auto& worker : workers){
+        workerIds.emplace(worker, static_cast<std::uint32_t>(workerIds.size()));
+        writeString(worker->getName());
+        records.writeUInt64(worker->getTaxId());
+        records.writeFloat(worker->getSalary());
+        writeString(worker->getCredential().username);
+        writeString(worker->getCredential().password);
+        writeString(worker->getLocation());
+    }
+
+    // orders are saved column by column, in priority order, so that they are added back in the same order
+    std::vector<const Order*> orders;
+    for (const auto& orderEntry : orderManager.getOrders()) orders.push_back(orderEntry.getOrder());
+    records.writeUInt32(static_cast<std::uint32_t>(orders.size()));
+    for (const auto& order : orders) records.writeUInt32(clientIds.at(order->getClient()));
+    for (const auto& order : orders) records.writeUInt32(workerIds.at(order->getWorker()));
+    for (const auto& order : orders) writeString(order->getDeliverLocation());
+    for (const auto& order : orders) records.writeUInt16(static_cast<std::uint16_t>(order->getRequestDate().getYear()));
+    for (const auto& order : orders) records.writeUInt8(static_cast<std::uint8_t>(order->getRequestDate().getMonth()));
+    for (const auto& order : orders) records.writeUInt8(static_cast<std::uint8_t>(order->getRequestDate().getDay()));
+    for (const auto& order : orders) records.writeUInt8(static_cast<std::uint8_t>(order->getRequestDate().getHour()));
+    for (const auto& order : orders) records.writeUInt8(static_cast<std::uint8_t>(order->getRequestDate().getMinute()));
+    for (const auto& order : orders)
+        records.writeUInt8(order->wasDelivered() ? static_cast<std::uint8_t>(order->getClientEvaluation())
+                                                 : UNDELIVERED_EVALUATION);
+    for (const auto& order : orders){
+        std::int32_t duration = order->wasDelivered() ?
+                order->getDeliverDate().getMinutes() - order->getRequestDate().getMinutes() : 0;
+        records.writeUInt32(static_cast<std::uint32_t>(duration));
+    }
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> orderProducts;
+    for (const auto& order : orders){
+        const OrderProducts& products = order->getProducts();
+        records.writeUInt32(static_cast<std::uint32_t>(products.size()));
+        for (const auto& product : products) orderProducts.emplace_back(productIds.at(product.first), product.second);
+    }
+    records.writeUInt32(static_cast<std::uint32_t>(orderProducts.size()));
+    for (const auto& product : orderProducts) records.writeUInt32(product.first);
+    for (const auto& product : orderProducts) records.writeUInt32(product.second);
+    orderManager.writeSketches(records, workerIds);
+
+    BinaryWriter file;
+    file.writeUInt32(static_cast<std::uint32_t>(strings.size()));
+    for (const auto& str : strings) file.writeString(*str);
+    file.append(records);
+    file.save(path, SNAPSHOT_MAGIC, SNAPSHOT_VERSION);
+}
+
+std::string Store::recover(const std::string &snapshotPath, const std::string &journalPath, unsigned groupSize) {
+    try {
+        setJournal(nullptr);
+        _journal.reset();
+        if (std::ifstream(snapshotPath)) loadSnapshot(snapshotPath);
+        for (auto& entry : Journal::read(journalPath, _journalGeneration)) replay(entry);
+
+        // the replayed operations are kept on a new snapshot, so that the journal can start over
+        ++_journalGeneration;
+        saveSnapshot(snapshotPath);
+        _snapshotPath = snapshotPath;
+        _journal.reset(new Journal(journalPath, _journalGeneration, groupSize));
+        setJournal(_journal.get());
+    }
+    catch (std::exception& e){
+        return "Recovery failed!\n" + std::string(e.what());
+    }
+    return "Recovery succeeded.";
+}
+
+std::string Store::checkpoint() {
+    if (!_journal) return "Checkpoint failed!\nThe store was not recovered from a snapshot.";
+    try {
+        _journal->sync();
+        ++_journalGeneration;
+        saveSnapshot(_snapshotPath);
+        _journal->restart(_journalGeneration);
+    }
+    catch (std::exception& e){
+        return "Checkpoint failed!\n" + std::string(e.what());
+    }
+    return "Checkpoint succeeded.";
+}
+
+void Store::setBossName(const std::string &name) {
+    boss.setName(name);
+    recordBoss();
+}
+
+void Store::setBossTaxID(unsigned long taxID) {
+    boss.setTaxID(taxID);
+    recordBoss();
+}
+
+void Store::setBossCredential(const Credential &credential) {
+    boss.setCredential(credential);
+    recordBoss();
+}
+
+void Store::recordBoss() {
+    if (!_journal) return;
+    JournalEntry entry(JournalOperation::BOSS_CHANGED);
+    entry.writePerson(&boss);
+    entry.writeString(boss.getCredential().username);
+    entry.writeString(boss.getCredential().password);
+    _journal->record(entry);
+}
+
+void Store::syncJournal() {
+    if (_journal) _journal->sync();
+}
+
+std::string Store::openArchive(const std::string &path) {
+    try {
+        // orders archived after the last snapshot are removed from the orders list, so save it without them
+        if (orderManager.openArchive(path) && _journal) checkpoint();
+    }
+    catch (std::exception& e){
+        return "Opening the archive failed!\n" + std::string(e.what());
+    }
+    return "Archive opened.";
+}
+
+unsigned long Store::archiveOrders(const Date &deliveredBefore) {
+    unsigned long archived = orderManager.archive(deliveredBefore);
+    if (archived && _journal) checkpoint();
+    return archived;
+}
+
+void Store::setJournal(Journal *journal) {
+    locationManager.setJournal(journal);
+    productManager.setJournal(journal);
+    clientManager.setJournal(journal);
+    workerManager.setJournal(journal);
+    orderManager.setJournal(journal);
+}
+
+void Store::replay(BinaryReader &entry) {
+    auto readPerson = [&](std::string& name) {
+        unsigned long taxID = entry.readUInt64();
+        name = entry.readString();
+        return taxID;
+    };
+    auto readClient = [&]() -> Client* {
+        std::string name;
+        unsigned long taxID = readPerson(name);
+        if (taxID != Person::DEFAULT_TAX_ID) return clientManager.getClient(taxID);
+        for (const auto& client : clientManager.getAll())
+            if (client->getTaxId() == taxID && client->getName() == name) return client;
+        throw PersonDoesNotExist(name, taxID);
+    };
+    auto readWorker = [&]() -> Worker* {
+        std::string name;
+        unsigned long taxID = readPerson(name);
+        if (taxID != Person::DEFAULT_TAX_ID) return workerManager.getWorker(taxID);
+        for (const auto& worker : workerManager.getAll())
+            if (worker->getTaxId() == taxID && worker->getName() == name) return worker;
+        throw PersonDoesNotExist(name, taxID);
+    };
+    auto readProduct = [&]() {
+        std::string name = entry.readString();
+        return productManager.get(name, entry.readFloat());
+    };
+    auto readDate = [&]() {
+        int year = entry.readUInt16();
+        int month = entry.readUInt8(), day = entry.readUInt8(), hour = entry.readUInt8(), minute = entry.readUInt8();
+        return Date(day, month, year, hour, minute);
+    };
+    auto readOrder = [&]() {
+        Client* client = readClient();
+        Worker* worker = readWorker();
+        std::string location = entry.readString();
+        return orderManager.get(client, worker, location, readDate());
+    };
+
+    switch (static_cast<JournalOperation>(entry.readUInt8())){
+        case JournalOperation::LOCATION_ADDED: locationManager.add(entry.readString()); break;
+        case JournalOperation::LOCATION_REMOVED: locationManager.remove(entry.readString()); break;
+        case JournalOperation::PRODUCT_ADDED: {
+            std::string name = entry.readString();
+            float price = entry.readFloat();
+            bool isCake = entry.readUInt8();
+            std::uint8_t variant = entry.readUInt8();
+            if (isCake) productManager.addCake(name, price, static_cast<CakeCategory>(variant));
+            else productManager.addBread(name, price, variant);
+            break;
+        }
+        case JournalOperation::PRODUCT_REMOVED: productManager.remove(readProduct()); break;
+        case JournalOperation::CLIENT_ADDED: {
+            std::string name;
+            unsigned long taxID = readPerson(name);
+            bool premium = entry.readUInt8();
+            std::string username = entry.readString();
+            clientManager.add(name, taxID, premium, {username, entry.readString()});
+            break;
+        }
+        case JournalOperation::CLIENT_REMOVED: clientManager.remove(readClient()); break;
+        case JournalOperation::CLIENT_TAX_ID_CHANGED: {
+            Client* client = readClient();
+            clientManager.setTaxID(client, entry.readUInt64());
+            break;
+        }
+        case JournalOperation::CLIENT_CREDENTIAL_CHANGED: {
+            Client* client = readClient();
+            std::string username = entry.readString();
+            clientManager.setCredential(client, {username, entry.readString()});
+            break;
+        }
+        case JournalOperation::WORKER_ADDED: {
+            std::string name;
+            unsigned long taxID = readPerson(name);
+            std::string location = entry.readString();
+            float salary = entry.readFloat();
+            std::string username = entry.readString();
+            workerManager.add(location, name, taxID, salary, {username, entry.readString()});
+            break;
+        }
+        case JournalOperation::WORKER_REMOVED: orderManager.removeWorker(readWorker()); break;
+        case JournalOperation::WORKER_TAX_ID_CHANGED: {
+            Worker* worker = readWorker();
+            workerManager.setTaxID(worker, entry.readUInt64());
+            break;
+        }
+        case JournalOperation::WORKER_CREDENTIAL_CHANGED: {
+            Worker* worker = readWorker();
+            std::string username = entry.readString();
+            workerManager.setCredential(worker, {username, entry.readString()});
+            break;
+        }
+        case JournalOperation::WORKER_SALARY_CHANGED: {
+            Worker* worker = readWorker();
+            worker->setSalary(entry.readFloat());
+            break;
+        }
+        case JournalOperation::SALARIES_RAISED: workerManager.raiseSalary(entry.readFloat()); break;
+        case JournalOperation::SALARIES_DECREASED: workerManager.decreaseSalary(entry.readFloat()); break;
+        case JournalOperation::ORDER_ADDED: {
+            Client* client = readClient();
+            Worker* worker = readWorker();
+            std::string location = entry.readString();
+            orderManager.add(client, worker, location, readDate());
+            break;
+        }
+        case JournalOperation::ORDER_REMOVED: orderManager.remove(readOrder()); break;
+        case JournalOperation::ORDER_PRODUCT_ADDED: {
+            Order* order = readOrder();
+            Product* product = readProduct();
+            orderManager.addProduct(order, product, entry.readUInt32());
+            break;
+        }
+        case JournalOperation::ORDER_PRODUCT_REMOVED: {
+            Order* order = readOrder();
+            orderManager.removeProduct(order, readProduct());
+            break;
+        }
+        case JournalOperation::ORDER_LOCATION_CHANGED: {
+            Order* order = readOrder();
+            std::string location = entry.readString();
+            orderManager.setDeliveryLocation(order, location, readWorker());
+            break;
+        }
+        case JournalOperation::ORDER_DELIVERED: {
+            Order* order = readOrder();
+            int evaluation = entry.readUInt8();
+            bool updatePoints = entry.readUInt8();
+            int deliverDuration = static_cast<int>(entry.readUInt32());
+            orderManager.deliver(order, evaluation, updatePoints, deliverDuration);
+            break;
+        }
+        // older journals have these, but the archived orders are only removed from the orders list when the archive is
+        // opened, so that they aren't counted twice
+        case JournalOperation::ORDER_ARCHIVED: readOrder(); break;
+        case JournalOperation::CLIENT_NAME_CHANGED: {
+            Client* client = readClient();
+            clientManager.setName(client, entry.readString());
+            break;
+        }
+        case JournalOperation::CLIENT_PREMIUM_CHANGED: {
+            Client* client = readClient();
+            clientManager.setPremium(client, entry.readUInt8());
+            break;
+        }
+        case JournalOperation::WORKER_NAME_CHANGED: {
+            Worker* worker = readWorker();
+            workerManager.setName(worker, entry.readString());
+            break;
+        }
+        case JournalOperation::BOSS_CHANGED: {
+            std::string name;
+            unsigned long taxID = readPerson(name);
+            std::string username = entry.readString();
+            boss.setName(name);
+            boss.setTaxID(taxID);
+            boss.setCredential({username, entry.readString()});
+            break;
+        }
+        default: throw InvalidFile(entry.getPath());
+    }
+    if (!entry.isAtEnd()) throw InvalidFile(entry.getPath());
+}
@@ -1,6 +1,8 @@
 #ifndef SRC_STORE_H
 #define SRC_STORE_H
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 #include <algorithm>
@@ -21,6 +23,7 @@
 #include "../person/worker/worker_manager.h"
 #include "../order/order_manager.h"
 #include "location_manager.h"
+#include "journal.h"
 
 class Order;
 
@@ -51,12 +54,12 @@ public:
     std::string getName() const;
 
     /**
-     * Gets the store evaluation given by the clients.
+     * Gets the store evaluation given by the clients, archived orders included.
      */
     int getEvaluation() const;
 
     /**
-     * Gets the store's profit.
+     * Gets the store's profit, archived orders included.
      *
      * @return the store's profit
      */
@@ -65,11 +68,14 @@ public:
     /**
     * Reads all the store data (boss, worker manager, product manager, client manager and order manager) from a
     * a file and creates new objects of the respective classes with that data.
+    * With more than one thread, the boss, locations, products and clients, which don't depend on each other, are read
+    * at the same time, and the orders file is parsed in blocks. The resulting store is the same either way.
     *
     * @param dataFolderPath the folder path
+    * @param threads the number of threads used to read the files
     * @return "Import succeeded." if the reading was succeeded; "Import failed!", otherwise
     */
-    std::string read(const std::string& dataFolderPath);
+    std::string read(const std::string& dataFolderPath, unsigned threads = 1);
 
     /**
      * Writes all the store data (boss, worker manager, product manager, client manager and order manager) to a file
@@ -80,6 +86,91 @@ public:
      */
     std::string write(const std::string& dataFolderPath);
 
+    /**
+     * Reads all the store data from a binary snapshot file, written by writeSnapshot().
+     *
+     * @param path the file path
+     * @return "Import succeeded." if the reading was succeeded; "Import failed!", otherwise
+     */
+    std::string readSnapshot(const std::string& path);
+
+    /**
+     * Writes all the store data to a binary snapshot file, which is much faster to write and read than the text files.
+     * Strings are kept once in a string table and referenced by index; clients, workers and products are referenced
+     * by their position in the snapshot; orders are saved column by column.
+     *
+     * @param path the file path
+     * @return "Export succeeded." if the writing was succeeded; "Export failed!", otherwise
+     */
+    std::string writeSnapshot(const std::string& path);
+
+    /**
+     * Loads the store from its last snapshot and replays the operations recorded on the journal since then. Then saves
+     * a new snapshot and starts recording the following changes on the journal, so that they aren't lost if the
+     * application stops before the next checkpoint.
+     *
+     * @param snapshotPath the snapshot file path; if the file doesn't exist, the store starts empty
+     * @param journalPath the journal file path
+     * @param groupSize the number of journal entries which are committed to the disk at once
+     * @return "Recovery succeeded." if the recovery was succeeded; "Recovery failed!", otherwise
+     */
+    std::string recover(const std::string& snapshotPath, const std::string& journalPath,
+                        unsigned groupSize = Journal::DEFAULT_GROUP_SIZE);
+
+    /**
+     * Saves a new snapshot of the store and erases the journal entries, which are now kept on the snapshot.
+     *
+     * @return "Checkpoint succeeded." if the snapshot was saved; "Checkpoint failed!", otherwise
+     */
+    std::string checkpoint();
+
+    /**
+     * Commits to the disk the journal entries which are still in memory.
+     */
+    void syncJournal();
+
+    /**
+     * Opens the orders archive, after the store was loaded.
+     *
+     * @param path the archive path
+     * @return "Archive opened." if the archive was opened; "Opening the archive failed!", otherwise
+     */
+    std::string openArchive(const std::string& path);
+
+    /**
+     * Moves the orders which were delivered before a certain date to the orders archive, and saves a checkpoint, so
+     * that a recovery doesn't bring them back to memory. If the store stops before the checkpoint, they are removed
+     * again when the archive is opened.
+     *
+     * @param deliveredBefore the date
+     * @return the number of archived orders
+     * @throws std::logic_error if the orders archive wasn't opened
+     * @throws FileNotFound if the archive can't be written
+     */
+    unsigned long archiveOrders(const Date& deliveredBefore);
+
+    /**
+     * Changes the name of the boss, recording it on the journal.
+     *
+     * @param name the new name
+     */
+    void setBossName(const std::string& name);
+
+    /**
+     * Changes the taxpayer identification number of the boss, recording it on the journal.
+     *
+     * @param taxID the new taxpayer identification number
+     */
+    void setBossTaxID(unsigned long taxID);
+
+    /**
+     * Changes the credential of the boss, recording it on the journal.
+     *
+     * @param credential the new credential
+     * @throws InvalidCredential if the credential uses reserved words
+     */
+    void setBossCredential(const Credential& credential);
+
     /**
      * The location manager associated to the store.
     */
@@ -110,11 +201,92 @@ public:
      */
     Boss boss;
 
+    /**
+     * The 4 characters which identify a snapshot file.
+     */
+    static const char* SNAPSHOT_MAGIC;
+
+    /**
+     * The current version of the snapshot format.
+     */
+    static const std::uint32_t SNAPSHOT_VERSION;
+
+    /**
+     * The evaluation saved in a snapshot for the orders which weren't delivered yet.
+     */
+    static const std::uint8_t UNDELIVERED_EVALUATION;
+
+    /**
+     * The snapshot file the application recovers the store from when it starts.
+     */
+    static const char* DEFAULT_SNAPSHOT_PATH;
+
+    /**
+     * The journal file where the application records the changes to the store.
+     */
+    static const char* DEFAULT_JOURNAL_PATH;
+
+    /**
+     * The path of the orders archive of the application.
+     */
+    static const char* DEFAULT_ARCHIVE_PATH;
+
 private:
+    /**
+     * Records the current name, taxpayer identification number and credential of the boss on the journal.
+     */
+    void recordBoss();
+
+    /**
+     * Reads all the store data from a binary snapshot file.
+     *
+     * @param path the file path
+     * @throws FileNotFound if the file can't be opened
+     * @throws InvalidFile if the file is corrupted
+     */
+    void loadSnapshot(const std::string& path);
+
+    /**
+     * Writes all the store data to a binary snapshot file.
+     *
+     * @param path the file path
+     * @throws FileNotFound if the file can't be opened
+     */
+    void saveSnapshot(const std::string& path);
+
+    /**
+     * Applies an operation recorded on the journal.
+     *
+     * @param entry the journal entry
+     */
+    void replay(BinaryReader& entry);
+
+    /**
+     * Sets the journal of all the managers.
+     *
+     * @param journal the journal; nullptr, if the changes must not be recorded
+     */
+    void setJournal(Journal* journal);
+
     /**
      * The store name.
      */
     std::string _name;
+
+    /**
+     * The path of the snapshot the journal follows.
+     */
+    std::string _snapshotPath;
+
+    /**
+     * The generation of the last snapshot, which is also the generation of the journal which follows it.
+     */
+    std::uint64_t _journalGeneration;
+
+    /**
+     * The journal where the changes since the last snapshot are recorded; nullptr, if they aren't recorded.
+     */
+    std::unique_ptr<Journal> _journal;
 };
 
 #endif //SRC_STORE_H
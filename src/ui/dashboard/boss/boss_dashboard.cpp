@@ -1,5 +1,7 @@
 #include "boss_dashboard.h"
 
+const int BossDashboard::ARCHIVE_AFTER_DAYS = 365;
+
 BossDashboard::BossDashboard(Store &store) : Dashboard(store, &store.boss), _boss(&store.boss) {
 }
 
@@ -15,6 +17,7 @@ void BossDashboard::show() {
             "manage staff - have a look at your workers",
             "manage clients - quickly peek and shout at them",
             "check stats - some math to keep you happy, boss",
+            "archive orders - move orders delivered over a year ago out of memory",
             "logout - exit and request credential next time"
     };
     printOptions(options);
@@ -54,12 +57,31 @@ void BossDashboard::show() {
             showStats();
             break;
         }
+        else if (validInput1Cmd1Arg(input,"archive","orders")){
+            archiveOrders();
+            break;
+        }
         else printError();
     }
 
     show();
 }
 
+void BossDashboard::archiveOrders() {
+    Date deliveredBefore;
+    deliveredBefore.addDays(-ARCHIVE_AFTER_DAYS);
+    std::cout << "\n" << SEPARATOR;
+    try {
+        std::cout << _store.archiveOrders(deliveredBefore) << " orders archived.\n";
+    }
+    catch (std::exception& e){
+        std::cout << e.what() << "\n";
+    }
+    std::cout << "Press enter to go back. ";
+    std::string input;
+    std::getline(std::cin, input);
+}
+
 void BossDashboard::addWorker() {
     std::cout << "\n" << SEPARATOR;
     std::string name, input, location;
@@ -139,13 +161,13 @@ void BossDashboard::manageStaff(std::string location) {
             if (input == BACK) return;
             else if (hasStaff && validInput1Cmd1ArgDigit(input,"fire")){
                 unsigned long idx = std::stoul(to_words(input).at(1)) - 1;
-                _store.workerManager.remove(idx);
+                _store.orderManager.removeWorker(_store.workerManager.get(idx));
                 break;
             }
             else if (hasStaff && validInput1Cmd2ArgsDigit(input,"set_salary",true)){
                 unsigned long idx = std::stoul(to_words(input).at(1)) - 1;
                 float salary = std::stof(to_words(input).at(2));
-                _store.workerManager.get(idx)->setSalary(salary);
+                _store.workerManager.setSalary(idx, salary);
                 break;
             }
             else if (hasStaff && validInput1Cmd1ArgDigit(input, "raise_salary", true)){
@@ -209,8 +231,80 @@ void BossDashboard::showStats() const{
     std::cout << SEPARATOR;
     util::print(_store.getName(), util::BLUE);
     std::cout << "\nMean evaluation: " << _store.getEvaluation()
-              << "\nRevenue: " << util::to_string(_store.getProfit()) << " euros\n"
-              << "\nIt's a nice day out there.\n" << SEPARATOR << "\n";
+              << "\nRevenue: " << util::to_string(_store.getProfit()) << " euros\n";
+
+    const OrderAnalytics& analytics = _store.orderManager.getAnalytics();
+    Date today, monthAgo;
+    monthAgo.addDays(-29);
+    std::cout << "\nLast 30 days\n" << util::column("Location", true) << util::column("Orders")
+              << util::column("Revenue") << util::column("Bread") << util::column("Cake")
+              << util::column("Evaluation") << "\n";
+    for (const auto& name : _store.locationManager.getAll()){
+        Location location(name);
+        AnalyticsTotals totals = analytics.get(monthAgo, today, &location);
+        float bread = analytics.get(monthAgo, today, &location, ProductType::BREAD).revenue;
+        float cake = analytics.get(monthAgo, today, &location, ProductType::CAKE).revenue;
+        std::cout << util::column(name, true) << util::column(std::to_string(totals.orders))
+                  << util::column(util::to_string(totals.revenue)) << util::column(util::to_string(bread))
+                  << util::column(util::to_string(cake))
+                  << util::column(util::to_string(totals.getMeanEvaluation())) << "\n";
+    }
+
+    int month = static_cast<int>(today.getMonth()) - 5, year = static_cast<int>(today.getYear());
+    if (month < 1) { month += 12; --year; }
+    Date halfYearAgo(1, month, year);
+    std::cout << "\nLast months\n" << util::column("Month", true) << util::column("Orders")
+              << util::column("Revenue") << util::column("Evaluation") << "\n";
+    for (const auto& month : analytics.getSeries(halfYearAgo, today, TimeBucket::MONTH)){
+        std::cout << util::column(month.from.getCalendarDay().substr(3), true)
+                  << util::column(std::to_string(month.orders)) << util::column(util::to_string(month.revenue))
+                  << util::column(util::to_string(month.getMeanEvaluation())) << "\n";
+    }
+
+    std::cout << "\nOrder value and delivery time\n" << util::column("Location", true) << util::column("Median value")
+              << util::column("95% value") << util::column("Median time") << util::column("95% time") << "\n";
+    for (const auto& name : _store.locationManager.getAll()){
+        const Location* location = Location::find(name);
+        if (!location) continue;
+        const DeliverySketches& sketches = _store.orderManager.getSketches(*location);
+        if (!sketches.value.getCount()) continue;
+        std::cout << util::column(name, true)
+                  << util::column(util::to_string(sketches.value.getQuantile(0.5)) + " euros")
+                  << util::column(util::to_string(sketches.value.getQuantile(0.95)) + " euros")
+                  << util::column(std::to_string(static_cast<int>(sketches.latency.getQuantile(0.5))) + " min")
+                  << util::column(std::to_string(static_cast<int>(sketches.latency.getQuantile(0.95))) + " min") << "\n";
+    }
+
+    std::cout << "\nBestsellers\n";
+    std::vector<std::pair<std::string, std::vector<Product*>>> bestsellers;
+    for (bool small : {true, false}){
+        std::vector<Bread*> breads = _store.productManager.getBestBreads(3, small);
+        bestsellers.emplace_back(Bread::getSizeCategory(small), std::vector<Product*>(breads.begin(), breads.end()));
+    }
+    for (int i = 0; i < 5; ++i){
+        std::vector<Cake*> cakes = _store.productManager.getBestCakes(3, static_cast<CakeCategory>(i));
+        bestsellers.emplace_back(Cake::categoryStr[i], std::vector<Product*>(cakes.begin(), cakes.end()));
+    }
+    for (const auto& category : bestsellers){
+        if (category.second.empty()) continue;
+        std::cout << util::column(category.first, true);
+        for (unsigned long i = 0; i < category.second.size(); ++i)
+            std::cout << (i ? ", " : "") << category.second.at(i)->getName();
+        std::cout << "\n";
+    }
+
+    std::cout << "\nBest workers (last " << WorkerScorecard::RECENT_DAYS << " days)\n" << util::column("Name", true)
+              << util::column("Orders") << util::column("Evaluation") << util::column("Revenue")
+              << util::column("To deliver") << "\n";
+    for (const auto& worker : _store.workerManager.getBestWorkers(3, today)){
+        const WorkerScorecard& scorecard = worker->getScorecard();
+        std::cout << util::column(worker->getName(), true)
+                  << util::column(std::to_string(scorecard.getRecentDeliveries(today)))
+                  << util::column(util::to_string(scorecard.getRecentMeanEvaluation(today)))
+                  << util::column(util::to_string(scorecard.getRevenue()))
+                  << util::column(std::to_string(worker->getUndeliveredOrders())) << "\n";
+    }
+    std::cout << "\nIt's a nice day out there.\n" << SEPARATOR << "\n";
 
     for(;;) {
         std::string input = readCommand();
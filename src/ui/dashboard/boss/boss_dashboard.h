@@ -59,6 +59,16 @@ private:
      */
     void showStats() const;
 
+    /**
+     * Move the orders delivered more than ARCHIVE_AFTER_DAYS days ago to the orders archive.
+     */
+    void archiveOrders();
+
+    /**
+     * The number of days after which delivered orders can be archived.
+     */
+    static const int ARCHIVE_AFTER_DAYS;
+
     /**
      * The boss who's logged in.
      */
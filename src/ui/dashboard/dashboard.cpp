@@ -4,6 +4,8 @@ Dashboard::Dashboard(Store &store, Person *person) : UI(store), _person(person){
 }
 
 void Dashboard::show() {
+    // every change is made from a dashboard, which is shown again after each command
+    _store.syncJournal();
     printLogo({});
     std::cout << SEPARATOR;
     print(_person->getName(),util::BLUE);
@@ -43,7 +45,7 @@ void Dashboard::manageOrders(Client *client, Worker* worker) {
                 break;
             } else if (hasOrders && client != nullptr && validInput1Cmd1ArgDigit(input,"remove")){
                 unsigned long idx = std::stoul(to_words(input).at(1)) - 1;
-                _store.orderManager.remove(idx);
+                _store.orderManager.remove(_store.orderManager.get(idx, client));
                 break;
             } else if (hasOrders && validInput1Cmd1ArgDigit(input, "expand")) {
                 unsigned long idx = std::stoul(to_words(input).at(1)) - 1;
@@ -94,7 +96,11 @@ void Dashboard::changeCredential(Person *person){
                     break;
                 }
             }
-            person->setCredential({username,password});
+            if (person->getRole() == PersonRole::CLIENT)
+                _store.clientManager.setCredential(dynamic_cast<Client*>(person), {username,password});
+            else if (person->getRole() == PersonRole::WORKER)
+                _store.workerManager.setCredential(dynamic_cast<Worker*>(person), {username,password});
+            else _store.setBossCredential({username,password});
             break;
         }
         catch(std::exception& e){
@@ -142,11 +148,11 @@ void Dashboard::managePersonalData(Person *person) {
                 changeName(person);
                 break;
             } else if (isClient && validInput1Cmd1Arg(input, "set", "basic")) {
-                _store.clientManager.getClient(person->getTaxId())->setPremium(false);
+                _store.clientManager.setPremium(dynamic_cast<Client*>(person), false);
                 break;
             }
             else if (isClient && validInput1Cmd1Arg(input, "set", "premium")) {
-                _store.clientManager.getClient(person->getTaxId())->setPremium(true);
+                _store.clientManager.setPremium(dynamic_cast<Client*>(person), true);
                 break;
             }
             else if (validInput1Cmd1Arg(input,"change","taxid")){
@@ -172,7 +178,11 @@ void Dashboard::changeName(Person *person) {
             std::string input2 = readCommand(false);
             if (input2 != input1) std::cout << "Names do not match! Try again.\n";
             else {
-                person->setName(input1);
+                if (person->getRole() == PersonRole::CLIENT)
+                    _store.clientManager.setName(dynamic_cast<Client*>(person), input1);
+                else if (person->getRole() == PersonRole::WORKER)
+                    _store.workerManager.setName(dynamic_cast<Worker*>(person), input1);
+                else _store.setBossName(input1);
                 break;
             }
         }
@@ -196,6 +206,13 @@ void Dashboard::editOrder(Order* order) {
         printLogo("Edit order");
         std::cout << "AVAILABLE STOCK\n" << SEPARATOR;
         _store.productManager.print(std::cout, false);
+        std::vector<Product*> bestsellers = _store.productManager.getBestsellers(3);
+        if (!bestsellers.empty()){
+            std::cout << "\nBestsellers: ";
+            for (unsigned long i = 0; i < bestsellers.size(); ++i)
+                std::cout << (i ? ", " : "") << bestsellers.at(i)->getName();
+            std::cout << "\n";
+        }
         std::cout << SEPARATOR << "\n"
                   << "ORDER DETAILS\n" << SEPARATOR;
         order->print(std::cout);
@@ -363,7 +380,12 @@ void Dashboard::changeTaxID(Person *person) {
             std::string input2 = readCommand(false);
             if (input2 != input1) std::cout << "IDs did not match! Try again.\n";
             else if (isdigit(input1)){
-                person->setTaxID(std::stoul(input1));
+                unsigned long taxID = std::stoul(input1);
+                if (person->getRole() == PersonRole::CLIENT)
+                    _store.clientManager.setTaxID(dynamic_cast<Client*>(person), taxID);
+                else if (person->getRole() == PersonRole::WORKER)
+                    _store.workerManager.setTaxID(dynamic_cast<Worker*>(person), taxID);
+                else _store.setBossTaxID(taxID);
                 break;
             }
             else std::cout << "Please enter a reasonable sized integer number!\n";
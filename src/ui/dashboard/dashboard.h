@@ -90,19 +90,19 @@ private:
      * Ask for new username, confirmation, new password and confirmation and sets them
      * @param person who wants to change credentials
      */
-    static void changeCredential(Person* person);
+    void changeCredential(Person* person);
 
     /**
      * Ask for new name and sets it
      * @param person who wants to change name
      */
-    static void changeName(Person* person);
+    void changeName(Person* person);
 
     /**
      * Ask for new taxID and sets it
      * @param person who wants to change taxID
      */
-    static void changeTaxID(Person* person);
+    void changeTaxID(Person* person);
 
     /**
      * Add a new bread: provide name, unit price and small attribute
@@ -12,6 +12,17 @@ void WorkerDashboard::show() {
     if (_worker->getMeanEvaluation() != 0) std::cout << util::to_string(_worker->getMeanEvaluation()) << " points\n";
     else std::cout << "None yet\n";
 
+    const WorkerScorecard& scorecard = _worker->getScorecard();
+    std::cout << "Delivered: " << scorecard.getDeliveries() << " orders, "
+              << util::to_string(scorecard.getRevenue()) << " euros\n"
+              << "Last " << WorkerScorecard::RECENT_DAYS << " days: " << scorecard.getRecentDeliveries() << " orders";
+    if (scorecard.getRecentDeliveries() != 0)
+        std::cout << ", " << util::to_string(scorecard.getRecentMeanEvaluation()) << " points";
+    std::cout << "\nEvaluations:";
+    for (unsigned long i = 0; i < scorecard.getHistogram().size(); ++i)
+        std::cout << (i ? ", " : " ") << i << ": " << scorecard.getHistogram().at(i);
+    std::cout << "\n";
+
     std::cout << SEPARATOR << "\n";
     const std::vector<std::string> options = {
             "edit account - change personal details",
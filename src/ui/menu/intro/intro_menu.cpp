@@ -1,23 +1,34 @@
 #include "intro_menu.h"
 #include "ui/menu/login/login_menu.h"
 
+#include <utility>
+
 void IntroMenu::show() {
+    _store.syncJournal();
     printLogo({});
     std::cout << SEPARATOR
               << "Welcome to the Bakery Store management app.\n"
-              << "You start with a blank store. Import data or start fresh.\n"
-              << "At any screen, type 'back' to go back.\n"
+              << "Your store is kept from the last session, and every change is saved as you go.\n";
+    if (!_recovery.empty()) std::cout << _recovery << "\n";
+    std::cout << "At any screen, type 'back' to go back.\n"
               << SEPARATOR << std::endl;
     const std::vector<std::string> content = {
             "import data - import data from files",
             "export data - export data to files",
-            "manage store - enter store management"
+            "import snapshot - import data from a snapshot file",
+            "export snapshot - export data to a snapshot file",
+            "save store - save the store now, so that it starts faster next time",
+            "manage store - enter store management",
+            "exit - save the store and leave"
     };
     printOptions(content);
 
     for (;;) {
         std::string input = readCommand();
-        if (input == EXIT) return;
+        if (input == EXIT) {
+            std::cout << _store.checkpoint() << "\n";
+            return;
+        }
         else if (validInput1Cmd1Arg(input, "manage","store")) {
             LoginMenu(_store).show();
             break;
@@ -30,13 +41,25 @@ void IntroMenu::show() {
             exportData();
             break;
         }
+        else if (validInput1Cmd1Arg(input,"import","snapshot")){
+            importSnapshot();
+            break;
+        }
+        else if (validInput1Cmd1Arg(input,"export","snapshot")){
+            exportSnapshot();
+            break;
+        }
+        else if (validInput1Cmd1Arg(input,"save","store")){
+            _recovery = _store.checkpoint();
+            break;
+        }
         else printError();
     }
 
     show();
 }
 
-IntroMenu::IntroMenu(Store &s) : UI(s) {
+IntroMenu::IntroMenu(Store &s, std::string recovery) : UI(s), _recovery(std::move(recovery)) {
 }
 
 void IntroMenu::importData() {
@@ -58,3 +81,23 @@ void IntroMenu::exportData() {
               << "\nPress enter to go back. ";
     std::getline(std::cin,input);
 }
+
+void IntroMenu::importSnapshot() {
+    std::cout << "\nIMPORT SNAPSHOT\n"
+    << SEPARATOR << "Snapshot file path: ";
+    std::string input = readCommand();
+    if (input == BACK) return;
+    std::cout << "\n" << _store.readSnapshot(input)
+    << "\nPress enter to go back. ";
+    std::getline(std::cin,input);
+}
+
+void IntroMenu::exportSnapshot() {
+    std::cout << "\nEXPORT SNAPSHOT\n" << SEPARATOR
+              << "Snapshot file path: ";
+    std::string input = readCommand();
+    if (input == BACK) return;
+    std::cout << "\n" << _store.writeSnapshot(input)
+              << "\nPress enter to go back. ";
+    std::getline(std::cin,input);
+}
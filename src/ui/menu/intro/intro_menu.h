@@ -11,8 +11,9 @@ public:
     /**
      * Create menu to show the main page
      * @param s store which info gets accessed and manipulated
+     * @param recovery the result of recovering the store from the last session
      */
-    explicit IntroMenu(Store& s);
+    explicit IntroMenu(Store& s, std::string recovery = {});
 
     /**
      * Show the main menu and command handler
@@ -28,6 +29,22 @@ public:
      * Asks the user for the "data" folder to which the store data will get exported
      */
     void exportData();
+
+    /**
+     * Asks the user for the snapshot file from which to import the store data
+     */
+    void importSnapshot();
+
+    /**
+     * Asks the user for the snapshot file to which the store data will get exported
+     */
+    void exportSnapshot();
+
+private:
+    /**
+     * The result of recovering the store from the last session.
+     */
+    std::string _recovery;
 };
 
 #endif //FEUP_AEDA_PROJECT_INTRO_MENU_H
@@ -47,7 +47,8 @@ void LoginMenu::selectPerson(PersonRole role) {
 
     if (hasPersons){
         const std::vector<std::string> options = {
-                "login <index> - login in person's account"
+                "login <index> - login in person's account",
+                "login username - login with your username and password"
         };
         printOptions(options);
     }
@@ -62,6 +63,10 @@ void LoginMenu::selectPerson(PersonRole role) {
                 else login(_store.clientManager.get(personPosition));
                 break;
             }
+            else if (hasPersons && validInput1Cmd1Arg(input,"login","username")) {
+                loginByUsername(role);
+                break;
+            }
             else printError();
         }
         catch (std::exception& e){
@@ -71,6 +76,47 @@ void LoginMenu::selectPerson(PersonRole role) {
     }
 }
 
+void LoginMenu::loginByUsername(PersonRole role) {
+    printLogo("Authentication");
+    std::cout << SEPARATOR << "Please enter your credentials.\n" << SEPARATOR;
+
+    std::vector<Person*> candidates;
+    std::cout << "\nUsername: ";
+    for (;;) {
+        std::string input = readCommand(false);
+        if (input == BACK) return;
+        if (role == PersonRole::WORKER){
+            std::vector<Worker*> workers = _store.workerManager.getByUsername(input);
+            candidates.assign(workers.begin(), workers.end());
+        }
+        else {
+            std::vector<Client*> clients = _store.clientManager.getByUsername(input);
+            candidates.assign(clients.begin(), clients.end());
+        }
+        if (!candidates.empty()) break;
+        std::cout << "Wrong username. Try again: ";
+    }
+
+    std::cout << "\nPassword: ";
+    for (;;) {
+        std::string input = readCommand(false);
+        if (input == BACK) return;
+        std::vector<Person*> matches;
+        for (const auto& candidate : candidates)
+            if (candidate->getCredential().password == input) matches.push_back(candidate);
+        if (matches.size() == 1){
+            matches.front()->setLogged(true);
+            login(matches.front());
+            return;
+        }
+        if (matches.size() > 1){
+            std::cout << "These credentials are shared by several accounts, please login by index.\n";
+            return;
+        }
+        std::cout << "Wrong password. Try again: ";
+    }
+}
+
 void LoginMenu::login(Person *person) {
     if (!person->isLogged()) {
         printLogo("Authentication");
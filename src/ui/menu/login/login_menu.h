@@ -27,6 +27,13 @@ public:
      */
     void selectPerson(PersonRole role);
 
+    /**
+     * Ask the user for its credential and find the person with that role who has it, through the username index.
+     * Instantiate respective dashboard if login successful and show it.
+     * @param role - the person role in the store
+     */
+    void loginByUsername(PersonRole role);
+
     /**
      * Ask the user for its credential.
      * Instantiate respective dashboard if login successful (or already logged in) and show it.
@@ -0,0 +1,604 @@
+#ifndef _AVL_H_
+#define _AVL_H_
+
+#include <algorithm>
+#include <iostream>
+#include <stack>
+#include <utility>
+#include <vector>
+using namespace std;
+
+template <class Comparable> class AVLItrIn;
+template <class Comparable> class AVL;
+
+template <class Comparable>
+class AVLNode
+{
+    Comparable element;
+    AVLNode *left;
+    AVLNode *right;
+    int height;
+    unsigned long size;
+
+    AVLNode( const Comparable & theElement, AVLNode *lt, AVLNode *rt )
+            : element( theElement ), left( lt ), right( rt ), height( 1 ), size( 1 ) { }
+
+    friend class AVL<Comparable>;
+    friend class AVLItrIn<Comparable>;
+};
+
+/**
+ * Balanced binary search tree (AVL) which keeps the size of each subtree, so that
+ * elements can also be found and removed by their rank in O(log n).
+ */
+template <class Comparable>
+class AVL
+{
+public:
+    explicit AVL( const Comparable & notFound );
+    AVL( const AVL & rhs );
+    ~AVL( );
+
+    const Comparable & findMin( ) const;
+    const Comparable & findMax( ) const;
+    const Comparable & find( const Comparable & x ) const;
+    const Comparable & findKth( unsigned long k ) const;
+    unsigned long rank( const Comparable & x ) const;
+    unsigned long size( ) const;
+    bool isEmpty( ) const;
+    void printTree( ) const;
+
+    void makeEmpty( );
+    bool insert( const Comparable & x );
+    bool remove( const Comparable & x );
+    bool replace( const Comparable & x, const Comparable & y );
+    bool replaceAll( std::vector<std::pair<Comparable, Comparable> > changes );
+
+    const AVL & operator=( const AVL & rhs );
+
+private:
+    AVLNode<Comparable> *root;
+    const Comparable ITEM_NOT_FOUND;
+
+    const Comparable & elementAt( AVLNode<Comparable> *t ) const;
+
+    bool insert( const Comparable & x, AVLNode<Comparable> * & t ) const;
+    bool remove( const Comparable & x, AVLNode<Comparable> * & t ) const;
+    AVLNode<Comparable> * findMin( AVLNode<Comparable> *t ) const;
+    AVLNode<Comparable> * findMax( AVLNode<Comparable> *t ) const;
+    AVLNode<Comparable> * find( const Comparable & x, AVLNode<Comparable> *t ) const;
+    AVLNode<Comparable> * findKth( unsigned long k, AVLNode<Comparable> *t ) const;
+    void makeEmpty( AVLNode<Comparable> * & t ) const;
+    void printTree( AVLNode<Comparable> *t ) const;
+    AVLNode<Comparable> * clone( AVLNode<Comparable> *t ) const;
+    AVLNode<Comparable> * build( const std::vector<Comparable> & sorted, unsigned long begin, unsigned long end ) const;
+
+    static int height( AVLNode<Comparable> *t );
+    static unsigned long size( AVLNode<Comparable> *t );
+    static void update( AVLNode<Comparable> *t );
+    static void rotateWithLeftChild( AVLNode<Comparable> * & k2 );
+    static void rotateWithRightChild( AVLNode<Comparable> * & k1 );
+    static void balance( AVLNode<Comparable> * & t );
+
+    friend class AVLItrIn<Comparable>;
+};
+
+// Note that all "matching" is based on the < method.
+
+template <class Comparable>
+AVL<Comparable>::AVL( const Comparable & notFound ) :
+        root(NULL), ITEM_NOT_FOUND( notFound )
+{ }
+
+template <class Comparable>
+AVL<Comparable>::AVL( const AVL<Comparable> & rhs ) : root( NULL ), ITEM_NOT_FOUND( rhs.ITEM_NOT_FOUND )
+{
+    *this = rhs;
+}
+
+template <class Comparable>
+AVL<Comparable>::~AVL( )
+{
+    makeEmpty( );
+}
+
+template <class Comparable>
+bool AVL<Comparable>::insert( const Comparable & x )
+{
+    return insert( x, root );
+}
+
+template <class Comparable>
+bool AVL<Comparable>::remove( const Comparable & x )
+{
+    return remove( x, root );
+}
+
+/**
+ * Replaces x by y. The node is updated in place when y keeps the rank of x;
+ * otherwise, x is removed and y is inserted.
+ * Returns false if x is not found or y is a duplicate.
+ */
+template <class Comparable>
+bool AVL<Comparable>::replace( const Comparable & x, const Comparable & y )
+{
+    AVLNode<Comparable> *t = root;
+    const Comparable *lower = NULL, *upper = NULL;
+    while( t != NULL )
+    {
+        if( x < t->element )
+        {
+            upper = &t->element;
+            t = t->left;
+        }
+        else if( t->element < x )
+        {
+            lower = &t->element;
+            t = t->right;
+        }
+        else
+            break;
+    }
+    if( t == NULL )
+        return false;   // Item not found; do nothing
+
+    if( t->left != NULL )
+        lower = &findMax( t->left )->element;
+    if( t->right != NULL )
+        upper = &findMin( t->right )->element;
+    if( ( lower == NULL || *lower < y ) && ( upper == NULL || y < *upper ) )
+    {
+        t->element = y;
+        return true;
+    }
+    if( find( y, root ) != NULL )
+        return false;   // Duplicate; do nothing
+    remove( x, root );
+    return insert( y, root );
+}
+
+/**
+ * Replaces the first element of each pair by the second one. When the changes are many for
+ * the size of the tree, the tree is rebuilt balanced in a single in-order pass, in
+ * O(n + k log k), rather than doing O(k log n) separate replacements.
+ * Returns false, leaving the tree unchanged, if any first element is not found or the
+ * result would have duplicates.
+ */
+template <class Comparable>
+bool AVL<Comparable>::replaceAll( std::vector<std::pair<Comparable, Comparable> > changes )
+{
+    unsigned long n = size( ), logN = 1;
+    while( ( 1UL << logN ) < n )
+        ++logN;
+    if( changes.size( ) * logN < n )
+    {
+        for( unsigned long i = 0; i < changes.size( ); ++i )
+            if( !replace( changes[ i ].first, changes[ i ].second ) )
+            {
+                // undo the replacements done so far
+                while( i-- > 0 )
+                    replace( changes[ i ].second, changes[ i ].first );
+                return false;
+            }
+        return true;
+    }
+
+    std::vector<Comparable> removed, added;
+    for( const auto & change : changes )
+    {
+        removed.push_back( change.first );
+        added.push_back( change.second );
+    }
+    std::sort( removed.begin( ), removed.end( ) );
+    std::sort( added.begin( ), added.end( ) );
+
+    // the kept elements come out of the in-order walk sorted, and are merged with the added ones
+    std::vector<Comparable> sorted;
+    sorted.reserve( n - removed.size( ) + added.size( ) );
+    unsigned long nextRemoved = 0, nextAdded = 0;
+    for( AVLItrIn<Comparable> it( *this ); !it.isAtEnd( ); it.advance( ) )
+    {
+        const Comparable & x = it.retrieve( );
+        if( nextRemoved < removed.size( ) && !( removed[ nextRemoved ] < x ) && !( x < removed[ nextRemoved ] ) )
+        {
+            ++nextRemoved;
+            continue;
+        }
+        while( nextAdded < added.size( ) && added[ nextAdded ] < x )
+            sorted.push_back( added[ nextAdded++ ] );
+        sorted.push_back( x );
+    }
+    while( nextAdded < added.size( ) )
+        sorted.push_back( added[ nextAdded++ ] );
+    if( nextRemoved != removed.size( ) )
+        return false;   // Item not found; do nothing
+    for( unsigned long i = 1; i < sorted.size( ); ++i )
+        if( !( sorted[ i - 1 ] < sorted[ i ] ) )
+            return false;   // Duplicate; do nothing
+
+    makeEmpty( );
+    root = build( sorted, 0, sorted.size( ) );
+    return true;
+}
+
+template <class Comparable>
+const Comparable & AVL<Comparable>::findMin( ) const
+{
+    return elementAt( findMin( root ) );
+}
+
+template <class Comparable>
+const Comparable & AVL<Comparable>::findMax( ) const
+{
+    return elementAt( findMax( root ) );
+}
+
+template <class Comparable>
+const Comparable & AVL<Comparable>::
+find( const Comparable & x ) const
+{
+    return elementAt( find( x, root ) );
+}
+
+/**
+ * Finds the element with k smaller elements (0-based rank).
+ * Returns ITEM_NOT_FOUND if k is out of range.
+ */
+template <class Comparable>
+const Comparable & AVL<Comparable>::
+findKth( unsigned long k ) const
+{
+    return elementAt( findKth( k, root ) );
+}
+
+/**
+ * Counts the elements smaller than x, which is the rank x has (or would have) in the tree.
+ */
+template <class Comparable>
+unsigned long AVL<Comparable>::
+rank( const Comparable & x ) const
+{
+    unsigned long smaller = 0;
+    AVLNode<Comparable> *t = root;
+    while( t != NULL )
+    {
+        if( x < t->element )
+            t = t->left;
+        else if( t->element < x )
+        {
+            smaller += size( t->left ) + 1;
+            t = t->right;
+        }
+        else
+            return smaller + size( t->left );
+    }
+    return smaller;
+}
+
+template <class Comparable>
+unsigned long AVL<Comparable>::size( ) const
+{
+    return size( root );
+}
+
+template <class Comparable>
+void AVL<Comparable>::makeEmpty( )
+{
+    makeEmpty( root );
+}
+
+template <class Comparable>
+bool AVL<Comparable>::isEmpty( ) const
+{
+    return root == NULL;
+}
+
+template <class Comparable>
+void AVL<Comparable>::printTree( ) const
+{
+    if( isEmpty( ) )
+        cout << "Empty tree" << endl;
+    else
+        printTree( root );
+}
+
+template <class Comparable>
+const AVL<Comparable> &
+AVL<Comparable>::
+operator=( const AVL<Comparable> & rhs )
+{
+    if( this != &rhs )
+    {
+        makeEmpty( );
+        root = clone( rhs.root );
+    }
+    return *this;
+}
+
+
+// private methods
+
+template <class Comparable>
+const Comparable & AVL<Comparable>::
+elementAt( AVLNode<Comparable> *t ) const
+{
+    if( t == NULL )
+        return ITEM_NOT_FOUND;
+    else
+        return t->element;
+}
+
+template <class Comparable>
+int AVL<Comparable>::height( AVLNode<Comparable> *t )
+{
+    return t == NULL ? 0 : t->height;
+}
+
+template <class Comparable>
+unsigned long AVL<Comparable>::size( AVLNode<Comparable> *t )
+{
+    return t == NULL ? 0 : t->size;
+}
+
+/**
+ * Recomputes the height and size of a node from its children.
+ */
+template <class Comparable>
+void AVL<Comparable>::update( AVLNode<Comparable> *t )
+{
+    int hl = height( t->left ), hr = height( t->right );
+    t->height = ( hl > hr ? hl : hr ) + 1;
+    t->size = size( t->left ) + size( t->right ) + 1;
+}
+
+template <class Comparable>
+void AVL<Comparable>::rotateWithLeftChild( AVLNode<Comparable> * & k2 )
+{
+    AVLNode<Comparable> *k1 = k2->left;
+    k2->left = k1->right;
+    k1->right = k2;
+    update( k2 );
+    update( k1 );
+    k2 = k1;
+}
+
+template <class Comparable>
+void AVL<Comparable>::rotateWithRightChild( AVLNode<Comparable> * & k1 )
+{
+    AVLNode<Comparable> *k2 = k1->right;
+    k1->right = k2->left;
+    k2->left = k1;
+    update( k1 );
+    update( k2 );
+    k1 = k2;
+}
+
+/**
+ * Restores the AVL property on a node whose subtrees differ in height by at most 2.
+ */
+template <class Comparable>
+void AVL<Comparable>::balance( AVLNode<Comparable> * & t )
+{
+    if( t == NULL )
+        return;
+    if( height( t->left ) - height( t->right ) > 1 )
+    {
+        if( height( t->left->left ) < height( t->left->right ) )
+            rotateWithRightChild( t->left );
+        rotateWithLeftChild( t );
+    }
+    else if( height( t->right ) - height( t->left ) > 1 )
+    {
+        if( height( t->right->right ) < height( t->right->left ) )
+            rotateWithLeftChild( t->right );
+        rotateWithRightChild( t );
+    }
+    else
+        update( t );
+}
+
+template <class Comparable>
+bool AVL<Comparable>::
+insert( const Comparable & x, AVLNode<Comparable> * & t ) const {
+    bool inserted;
+    if (t == NULL) {
+        t = new AVLNode<Comparable>(x, NULL, NULL);
+        return true;
+    }
+    else if( x < t->element )
+        inserted = insert( x, t->left );
+    else if( t->element < x )
+        inserted = insert( x, t->right );
+    else
+        return false;  // Duplicate; do nothing
+    if( inserted )
+        balance( t );
+    return inserted;
+}
+
+template <class Comparable>
+bool AVL<Comparable>::
+remove( const Comparable & x, AVLNode<Comparable> * & t ) const
+{
+    bool removed;
+    if( t == NULL )
+        return false;   // Item not found; do nothing
+    if( x < t->element )
+        removed = remove( x, t->left );
+    else if( t->element < x )
+        removed = remove( x, t->right );
+    else if( t->left != NULL && t->right != NULL ) // Two children
+    {
+        t->element = findMin( t->right )->element;
+        removed = remove( t->element, t->right );
+    }
+    else
+    {
+        AVLNode<Comparable> *oldNode = t;
+        t = ( t->left != NULL ) ? t->left : t->right;
+        delete oldNode;
+        return true;
+    }
+    if( removed )
+        balance( t );
+    return removed;
+}
+
+template <class Comparable>
+AVLNode<Comparable> *
+AVL<Comparable>::findMin( AVLNode<Comparable> *t ) const
+{
+    if( t != NULL )
+        while( t->left != NULL )
+            t = t->left;
+    return t;
+}
+
+template <class Comparable>
+AVLNode<Comparable> *
+AVL<Comparable>::findMax( AVLNode<Comparable> *t ) const
+{
+    if( t != NULL )
+        while( t->right != NULL )
+            t = t->right;
+    return t;
+}
+
+template <class Comparable>
+AVLNode<Comparable> *
+AVL<Comparable>::
+find( const Comparable & x, AVLNode<Comparable> *t ) const
+{
+    while( t != NULL )
+        if( x < t->element )
+            t = t->left;
+        else if( t->element < x )
+            t = t->right;
+        else
+            return t;    // Match
+
+    return NULL;   // No match
+}
+
+template <class Comparable>
+AVLNode<Comparable> *
+AVL<Comparable>::
+findKth( unsigned long k, AVLNode<Comparable> *t ) const
+{
+    while( t != NULL )
+    {
+        unsigned long leftSize = size( t->left );
+        if( k < leftSize )
+            t = t->left;
+        else if( k > leftSize )
+        {
+            k -= leftSize + 1;
+            t = t->right;
+        }
+        else
+            return t;
+    }
+    return NULL;
+}
+
+/**
+ * Internal method to make subtree empty.
+ */
+template <class Comparable>
+void AVL<Comparable>::
+makeEmpty( AVLNode<Comparable> * & t ) const
+{
+    if( t != NULL )
+    {
+        makeEmpty( t->left );
+        makeEmpty( t->right );
+        delete t;
+    }
+    t = NULL;
+}
+
+template <class Comparable>
+void AVL<Comparable>::printTree( AVLNode<Comparable> *t ) const
+{
+    if( t != NULL )
+    {
+        printTree( t->left );
+        cout << t->element << endl;
+        printTree( t->right );
+    }
+}
+
+template <class Comparable>
+AVLNode<Comparable> *
+AVL<Comparable>::clone( AVLNode<Comparable> * t ) const
+{
+    if( t == NULL )
+        return NULL;
+    AVLNode<Comparable> *copy = new AVLNode<Comparable>( t->element, clone( t->left ), clone( t->right ) );
+    copy->height = t->height;
+    copy->size = t->size;
+    return copy;
+}
+
+/**
+ * Builds a balanced tree with the elements sorted[ begin, end ).
+ */
+template <class Comparable>
+AVLNode<Comparable> *
+AVL<Comparable>::build( const std::vector<Comparable> & sorted, unsigned long begin, unsigned long end ) const
+{
+    if( begin >= end )
+        return NULL;
+    unsigned long middle = begin + ( end - begin ) / 2;
+    AVLNode<Comparable> *t = new AVLNode<Comparable>( sorted[ middle ], build( sorted, begin, middle ), build( sorted, middle + 1, end ) );
+    update( t );
+    return t;
+}
+
+
+/**************
+// Iterador em ordem
+**************/
+
+template <class Comparable>
+class AVLItrIn {
+public:
+    AVLItrIn(const AVL<Comparable> &bt);
+
+    void advance();
+    const Comparable &retrieve() { return itrStack.top()->element; }
+    bool isAtEnd() {return itrStack.empty(); }
+
+private:
+    stack<AVLNode<Comparable> *> itrStack;
+
+    void slideLeft(AVLNode<Comparable> *n);
+};
+
+template <class Comparable>
+AVLItrIn<Comparable>::AVLItrIn (const AVL<Comparable> &bt)
+{
+    if (!bt.isEmpty())
+        slideLeft(bt.root);
+}
+
+template <class Comparable>
+void AVLItrIn<Comparable>::slideLeft(AVLNode<Comparable> *n)
+{
+    while (n) {
+        itrStack.push(n);
+        n = n->left;
+    }
+}
+
+template <class Comparable>
+void AVLItrIn<Comparable>::advance()
+{
+    AVLNode<Comparable> * actual = itrStack.top();
+    itrStack.pop();
+    AVLNode<Comparable> * seguinte = actual->right;
+    if (seguinte)
+        slideLeft(seguinte);
+}
+
+#endif
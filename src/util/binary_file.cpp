@@ -0,0 +1,202 @@
+#include "binary_file.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "util.h"
+#include "exception/file_exception.h"
+
+namespace {
+    /**
+     * The size of the header: magic, version, payload size and checksum.
+     */
+    const std::size_t HEADER_SIZE = 4 + 4 + 8 + 8;
+
+    /**
+     * Forces the contents of an open file to reach the disk.
+     *
+     * @param file the file
+     * @return true, if the file was synced; false, otherwise
+     */
+    bool syncFile(std::FILE* file) {
+        if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+    /**
+     * Forces the entries of the directory of a file to reach the disk, so that a rename to that file is kept.
+     * Windows doesn't allow opening directories like this, and keeps renames on its own metadata journal.
+     *
+     * @param path the file path
+     */
+    void syncDirectory(const std::string& path) {
+#ifndef _WIN32
+        std::string::size_type slash = path.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+        int fd = ::open(directory.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        fsync(fd);
+        close(fd);
+#endif
+    }
+
+    std::uint64_t checksum(const std::vector<char>& data) {
+        return util::hash(data.data(), data.size());
+    }
+
+    void encode(char* bytes, std::uint64_t n, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) bytes[i] = static_cast<char>((n >> (8 * i)) & 0xff);
+    }
+
+    std::uint64_t decode(const char* bytes, std::size_t size) {
+        std::uint64_t n = 0;
+        for (std::size_t i = 0; i < size; ++i) n |= std::uint64_t(static_cast<unsigned char>(bytes[i])) << (8 * i);
+        return n;
+    }
+}
+
+BinaryWriter::BinaryWriter() : _data() {
+}
+
+void BinaryWriter::writeUInt8(std::uint8_t n) {
+    _data.push_back(static_cast<char>(n));
+}
+
+void BinaryWriter::writeUInt16(std::uint16_t n) {
+    char bytes[2]; encode(bytes, n, 2);
+    _data.insert(_data.end(), bytes, bytes + 2);
+}
+
+void BinaryWriter::writeUInt32(std::uint32_t n) {
+    char bytes[4]; encode(bytes, n, 4);
+    _data.insert(_data.end(), bytes, bytes + 4);
+}
+
+void BinaryWriter::writeUInt64(std::uint64_t n) {
+    char bytes[8]; encode(bytes, n, 8);
+    _data.insert(_data.end(), bytes, bytes + 8);
+}
+
+void BinaryWriter::writeFloat(float n) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &n, sizeof(bits));
+    writeUInt32(bits);
+}
+
+void BinaryWriter::writeString(const std::string &str) {
+    writeUInt32(static_cast<std::uint32_t>(str.size()));
+    _data.insert(_data.end(), str.begin(), str.end());
+}
+
+void BinaryWriter::append(const BinaryWriter &writer) {
+    _data.insert(_data.end(), writer._data.begin(), writer._data.end());
+}
+
+const std::vector<char> &BinaryWriter::getData() const {
+    return _data;
+}
+
+void BinaryWriter::save(const std::string &path, const char *magic, std::uint32_t version) const {
+    // the file is written aside, synced and then renamed, so that the previous one is kept if the application or the
+    // system stops meanwhile
+    const std::string temporaryPath = path + ".tmp";
+    std::FILE* file = std::fopen(temporaryPath.c_str(), "wb");
+    if (!file) throw FileNotFound(path);
+
+    char header[HEADER_SIZE];
+    std::memcpy(header, magic, 4);
+    encode(header + 4, version, 4);
+    encode(header + 8, _data.size(), 8);
+    encode(header + 16, checksum(_data), 8);
+    bool written = std::fwrite(header, 1, HEADER_SIZE, file) == HEADER_SIZE
+            && std::fwrite(_data.data(), 1, _data.size(), file) == _data.size()
+            && syncFile(file);
+    if (std::fclose(file) != 0 || !written) throw FileNotFound(path);
+
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0){
+        // renaming over an existing file isn't allowed on every platform
+        std::remove(path.c_str());
+        if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) throw FileNotFound(path);
+    }
+    // only once the rename is on the disk can the caller drop what the previous file didn't have, e.g. a journal
+    syncDirectory(path);
+}
+
+BinaryReader::BinaryReader(const std::string &path, const char *magic, std::uint32_t version) :
+        _path(path), _data(), _position(0) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw FileNotFound(path);
+
+    char header[HEADER_SIZE];
+    if (!file.read(header, HEADER_SIZE) || std::memcmp(header, magic, 4) != 0 || decode(header + 4, 4) != version)
+        throw InvalidFile(path);
+
+    std::uint64_t size = decode(header + 8, 8);
+    file.seekg(0, std::ios::end);
+    if (static_cast<std::uint64_t>(file.tellg()) != HEADER_SIZE + size) throw InvalidFile(path);
+    file.seekg(HEADER_SIZE, std::ios::beg);
+
+    _data.resize(static_cast<std::size_t>(size));
+    if (!file.read(_data.data(), static_cast<std::streamsize>(size)) || checksum(_data) != decode(header + 16, 8))
+        throw InvalidFile(path);
+}
+
+BinaryReader::BinaryReader(std::vector<char> data, std::string path) :
+        _path(std::move(path)), _data(std::move(data)), _position(0) {
+}
+
+const char *BinaryReader::take(std::size_t size) {
+    if (size > _data.size() - _position) throw InvalidFile(_path);
+    const char* bytes = _data.data() + _position;
+    _position += size;
+    return bytes;
+}
+
+std::uint8_t BinaryReader::readUInt8() {
+    return static_cast<std::uint8_t>(decode(take(1), 1));
+}
+
+std::uint16_t BinaryReader::readUInt16() {
+    return static_cast<std::uint16_t>(decode(take(2), 2));
+}
+
+std::uint32_t BinaryReader::readUInt32() {
+    return static_cast<std::uint32_t>(decode(take(4), 4));
+}
+
+std::uint64_t BinaryReader::readUInt64() {
+    return decode(take(8), 8);
+}
+
+float BinaryReader::readFloat() {
+    std::uint32_t bits = readUInt32();
+    float n;
+    std::memcpy(&n, &bits, sizeof(n));
+    return n;
+}
+
+std::string BinaryReader::readString() {
+    std::uint32_t size = readUInt32();
+    const char* bytes = take(size);
+    return std::string(bytes, size);
+}
+
+bool BinaryReader::isAtEnd() const {
+    return _position == _data.size();
+}
+
+const std::string &BinaryReader::getPath() const {
+    return _path;
+}
@@ -0,0 +1,142 @@
+#ifndef FEUP_AEDA_PROJECT_BINARY_FILE_H
+#define FEUP_AEDA_PROJECT_BINARY_FILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Class which builds a binary file in memory and saves it at once.
+ * Numbers are written in little endian with a fixed width. The saved file starts with a header holding a magic
+ * identifier, a format version, the payload size and a checksum of the payload.
+ */
+class BinaryWriter {
+public:
+    /**
+     * Creates a new empty BinaryWriter object.
+     */
+    BinaryWriter();
+
+    void writeUInt8(std::uint8_t n);
+    void writeUInt16(std::uint16_t n);
+    void writeUInt32(std::uint32_t n);
+    void writeUInt64(std::uint64_t n);
+    void writeFloat(float n);
+
+    /**
+     * Writes a string, preceded by its length.
+     *
+     * @param str the string
+     */
+    void writeString(const std::string& str);
+
+    /**
+     * Appends the payload of another writer.
+     *
+     * @param writer the other writer
+     */
+    void append(const BinaryWriter& writer);
+
+    /**
+     * Gets the payload written so far.
+     *
+     * @return the payload
+     */
+    const std::vector<char>& getData() const;
+
+    /**
+     * Saves the header and the payload to a file. The file is replaced atomically and is on the disk, rename included,
+     * once this returns.
+     *
+     * @param path the file path
+     * @param magic the 4 characters which identify the file format
+     * @param version the format version
+     * @throws FileNotFound if the file can't be written
+     */
+    void save(const std::string& path, const char* magic, std::uint32_t version) const;
+
+private:
+    /**
+     * The payload.
+     */
+    std::vector<char> _data;
+};
+
+/**
+ * Class which loads a binary file saved by a BinaryWriter, checking its header and checksum, and reads it back.
+ */
+class BinaryReader {
+public:
+    /**
+     * Creates a new BinaryReader object, loading the whole file.
+     *
+     * @param path the file path
+     * @param magic the 4 characters which identify the file format
+     * @param version the expected format version
+     * @throws FileNotFound if the file can't be opened
+     * @throws InvalidFile if the header doesn't match or the checksum is wrong
+     */
+    BinaryReader(const std::string& path, const char* magic, std::uint32_t version);
+
+    /**
+     * Creates a new BinaryReader object over a payload which is already in memory.
+     *
+     * @param data the payload
+     * @param path the path of the file where the payload came from
+     */
+    BinaryReader(std::vector<char> data, std::string path);
+
+    std::uint8_t readUInt8();
+    std::uint16_t readUInt16();
+    std::uint32_t readUInt32();
+    std::uint64_t readUInt64();
+    float readFloat();
+
+    /**
+     * Reads a string, preceded by its length.
+     *
+     * @return the string
+     */
+    std::string readString();
+
+    /**
+     * Checks if the whole payload was read.
+     *
+     * @return true, if the whole payload was read; false, otherwise
+     */
+    bool isAtEnd() const;
+
+    /**
+     * Gets the path of the file.
+     *
+     * @return the path
+     */
+    const std::string& getPath() const;
+
+private:
+    /**
+     * Gets a pointer to the next bytes of the payload, moving past them.
+     *
+     * @param size the number of bytes
+     * @return the pointer to the bytes
+     * @throws InvalidFile if there aren't enough bytes left
+     */
+    const char* take(std::size_t size);
+
+    /**
+     * The path of the file.
+     */
+    std::string _path;
+
+    /**
+     * The payload.
+     */
+    std::vector<char> _data;
+
+    /**
+     * The position of the next byte to read.
+     */
+    std::size_t _position;
+};
+
+#endif //FEUP_AEDA_PROJECT_BINARY_FILE_H
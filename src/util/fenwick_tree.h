@@ -0,0 +1,115 @@
+#ifndef FEUP_AEDA_PROJECT_FENWICK_TREE_H
+#define FEUP_AEDA_PROJECT_FENWICK_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Binary indexed tree over a growable array of values, answering the sum of any range of values from prefix sums.
+ * Both adding to a value and summing a range take logarithmic time. The array grows on demand at the end, and can be
+ * shifted to make room at the front.
+ *
+ * @tparam T the value type
+ */
+template <class T>
+class FenwickTree {
+public:
+    /**
+     * Creates a new empty FenwickTree object.
+     */
+    FenwickTree() : _tree() {};
+
+    /**
+     * Gets the number of values, including the ones which were never added to.
+     *
+     * @return the number of values
+     */
+    std::size_t size() const { return _tree.size(); };
+
+    /**
+     * Adds to a value, growing the array if needed.
+     *
+     * @param index the index of the value
+     * @param value the value to add
+     */
+    void add(std::size_t index, const T& value) {
+        if (index >= _tree.size()) grow(index + 1);
+        for (++index; index <= _tree.size(); index += index & (~index + 1)) _tree[index - 1] += value;
+    };
+
+    /**
+     * Sums the first values.
+     *
+     * @param end the number of values to sum
+     * @return the sum of the values before end
+     */
+    T sum(std::size_t end) const {
+        T result = T();
+        for (end = std::min(end, _tree.size()); end; end &= end - 1) result += _tree[end - 1];
+        return result;
+    };
+
+    /**
+     * Sums a range of values.
+     *
+     * @param begin the index of the first value
+     * @param end the index after the last value
+     * @return the sum of the values from begin to end (exclusive)
+     */
+    T sum(std::size_t begin, std::size_t end) const {
+        return begin < end ? sum(end) - sum(begin) : T();
+    };
+
+    /**
+     * Inserts zeros before the first value, so that every index moves forward.
+     *
+     * @param count the number of zeros
+     */
+    void shift(std::size_t count) {
+        std::vector<T> values(_tree.size() + count, T());
+        for (std::size_t i = 0; i < _tree.size(); ++i) values[count + i] = sum(i, i + 1);
+
+        _tree.assign(capacityFor(values.size()), T());
+        std::copy(values.begin(), values.end(), _tree.begin());
+        for (std::size_t i = 1; i <= _tree.size(); ++i){
+            std::size_t parent = i + (i & (~i + 1));
+            if (parent <= _tree.size()) _tree[parent - 1] += _tree[i - 1];
+        }
+    };
+
+private:
+    /**
+     * Gets the smallest power of two which holds a number of values.
+     *
+     * @param size the number of values
+     * @return the capacity
+     */
+    static std::size_t capacityFor(std::size_t size) {
+        std::size_t capacity = 1;
+        while (capacity < size) capacity *= 2;
+        return capacity;
+    };
+
+    /**
+     * Doubles the array until it holds a number of values. Since its size is always a power of two, the new last
+     * node covers the whole array and every other new node covers new (zero) values only.
+     *
+     * @param size the number of values
+     */
+    void grow(std::size_t size) {
+        if (_tree.empty()) _tree.resize(1, T());
+        while (_tree.size() < size){
+            T total = sum(_tree.size());
+            _tree.resize(_tree.size() * 2, T());
+            _tree.back() = total;
+        }
+    };
+
+    /**
+     * The tree nodes; node i (1-based) holds the sum of the values from i - lowbit(i) to i - 1.
+     */
+    std::vector<T> _tree;
+};
+
+#endif //FEUP_AEDA_PROJECT_FENWICK_TREE_H
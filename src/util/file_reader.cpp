@@ -0,0 +1,168 @@
+#include "file_reader.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include "exception/file_exception.h"
+
+FileReader::FileReader(const std::string& path) : _buffer(), _end(nullptr), _next(nullptr), _lineBegin(nullptr),
+        _lineEnd(nullptr), _cursor(nullptr) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw FileNotFound(path);
+
+    file.seekg(0, std::ios::end);
+    std::streamoff size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (size > 0) {
+        _buffer.resize(static_cast<std::size_t>(size));
+        file.read(_buffer.data(), size);
+        _buffer.resize(static_cast<std::size_t>(file.gcount()));
+    }
+    _buffer.push_back('\0');
+
+    _next = _lineBegin = _lineEnd = _cursor = _buffer.data();
+    _end = _buffer.data() + _buffer.size() - 1;
+}
+
+FileReader::FileReader(const char *begin, const char *end) : _buffer(), _end(end), _next(begin), _lineBegin(begin),
+        _lineEnd(begin), _cursor(begin) {
+}
+
+std::vector<FileReader> FileReader::split(unsigned parts, char separator) const {
+    std::vector<FileReader> result;
+    const char* begin = _next;
+    for (unsigned i = 1; i < parts; ++i) {
+        // look for the first separator line which starts after the ideal boundary
+        const char* target = _next + (_end - _next) * i / parts;
+        if (target <= begin) continue;
+        const char* position = target - 1;
+        while (position < _end && !(*position == '\n' && position + 1 < _end && position[1] == separator)) {
+            position = static_cast<const char*>(std::memchr(position + 1, '\n', _end - position - 1));
+            if (!position) position = _end;
+        }
+        if (position == _end) break;
+
+        auto lineEnd = static_cast<const char*>(std::memchr(position + 1, '\n', _end - position - 1));
+        const char* boundary = lineEnd ? lineEnd + 1 : _end;
+        result.emplace_back(FileReader(begin, boundary));
+        begin = boundary;
+    }
+    if (begin < _end || result.empty()) result.emplace_back(FileReader(begin, _end));
+    return result;
+}
+
+bool FileReader::nextLine() {
+    if (_next >= _end) return false;
+
+    _lineBegin = _cursor = _next;
+    auto newLine = static_cast<const char*>(std::memchr(_next, '\n', _end - _next));
+    _lineEnd = newLine ? newLine : _end;
+    _next = newLine ? newLine + 1 : _end;
+    if (_lineEnd > _lineBegin && *(_lineEnd - 1) == '\r') --_lineEnd;
+    return true;
+}
+
+bool FileReader::isLineEmpty() const {
+    return _lineBegin == _lineEnd;
+}
+
+char FileReader::lineFront() const {
+    return isLineEmpty() ? '\0' : *_lineBegin;
+}
+
+bool FileReader::isLine(const char* str) const {
+    std::size_t length = std::strlen(str);
+    return length == static_cast<std::size_t>(_lineEnd - _lineBegin) && std::memcmp(_lineBegin, str, length) == 0;
+}
+
+std::string FileReader::line(bool dashesAsSpaces) const {
+    std::string str(_lineBegin, _lineEnd);
+    if (dashesAsSpaces) for (auto& c : str) if (c == '-') c = ' ';
+    return str;
+}
+
+bool FileReader::nextField(const char*& begin, const char*& end) {
+    while (_cursor < _lineEnd && (*_cursor == ' ' || *_cursor == '\t')) ++_cursor;
+    if (_cursor == _lineEnd) return false;
+
+    begin = _cursor;
+    while (_cursor < _lineEnd && *_cursor != ' ' && *_cursor != '\t') ++_cursor;
+    end = _cursor;
+    return true;
+}
+
+bool FileReader::readField(const char*& begin, const char*& end) {
+    const char *fieldBegin, *fieldEnd;
+    if (!nextField(fieldBegin, fieldEnd)) return false;
+
+    begin = fieldBegin;
+    end = fieldEnd;
+    return true;
+}
+
+bool FileReader::read(std::string& str, bool dashesAsSpaces) {
+    const char *begin, *end;
+    if (!nextField(begin, end)) return false;
+
+    str.assign(begin, end);
+    if (dashesAsSpaces) for (auto& c : str) if (c == '-') c = ' ';
+    return true;
+}
+
+bool FileReader::readInteger(unsigned long& n, bool& negative) {
+    const char *begin, *end;
+    if (!nextField(begin, end)) return false;
+
+    negative = *begin == '-';
+    if (negative || *begin == '+') ++begin;
+    if (begin == end) return false;
+
+    unsigned long value = 0;
+    for (const char* c = begin; c < end; ++c) {
+        if (*c < '0' || *c > '9') return false;
+        unsigned digit = *c - '0';
+        if (value > (std::numeric_limits<unsigned long>::max() - digit) / 10) return false;
+        value = value * 10 + digit;
+    }
+    n = value;
+    return true;
+}
+
+bool FileReader::read(unsigned long& n) {
+    unsigned long value;
+    bool negative;
+    if (!readInteger(value, negative) || negative) return false;
+    n = value;
+    return true;
+}
+
+bool FileReader::read(unsigned& n) {
+    unsigned long value;
+    bool negative;
+    if (!readInteger(value, negative) || negative || value > std::numeric_limits<unsigned>::max()) return false;
+    n = static_cast<unsigned>(value);
+    return true;
+}
+
+bool FileReader::read(int& n) {
+    unsigned long value;
+    bool negative;
+    if (!readInteger(value, negative)) return false;
+    if (value > static_cast<unsigned long>(std::numeric_limits<int>::max()) + negative) return false;
+    n = negative ? static_cast<int>(-static_cast<long>(value)) : static_cast<int>(value);
+    return true;
+}
+
+bool FileReader::read(float& n) {
+    const char *begin, *end;
+    if (!nextField(begin, end)) return false;
+
+    // the buffer ends with a null character, so strtof can't go past it, and stops at the next whitespace
+    char* parsedEnd = nullptr;
+    float value = std::strtof(begin, &parsedEnd);
+    if (parsedEnd != end) return false;
+    n = value;
+    return true;
+}
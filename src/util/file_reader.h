@@ -0,0 +1,181 @@
+#ifndef FEUP_AEDA_PROJECT_FILE_READER_H
+#define FEUP_AEDA_PROJECT_FILE_READER_H
+
+#include <string>
+#include <vector>
+
+/**
+ * Class which loads a whole data file into memory and splits it, in place, into lines and whitespace separated fields.
+ * Fields are only copied when they are read as strings; numbers are parsed straight from the buffer.
+ * The buffer is only read after being loaded, so parts of it can be read by several threads at once.
+ */
+class FileReader {
+public:
+    /**
+     * Creates a new FileReader object, loading the whole file.
+     *
+     * @param path the file path
+     * @throws FileNotFound if the file can't be opened
+     */
+    explicit FileReader(const std::string& path);
+
+    FileReader(FileReader&&) = default;
+    FileReader(const FileReader&) = delete;
+    FileReader& operator=(const FileReader&) = delete;
+
+    /**
+     * Splits the remaining lines into about equally sized parts which can be read independently, each one ending right
+     * after a separator line. The parts point to the buffer of this reader, so it must outlive them.
+     *
+     * @param parts the maximum number of parts
+     * @param separator the first character of the separator lines
+     * @return the list of parts; a single one, if there aren't enough separators
+     */
+    std::vector<FileReader> split(unsigned parts, char separator) const;
+
+    /**
+     * Moves to the next line, ignoring a Windows carriage return at its end.
+     *
+     * @return true, if there was another line; false, if the end of the file was reached
+     */
+    bool nextLine();
+
+    /**
+     * Checks if the current line is empty.
+     *
+     * @return true, if the line is empty; false, otherwise
+     */
+    bool isLineEmpty() const;
+
+    /**
+     * Gets the first character of the current line.
+     *
+     * @return the first character; '\0', if the line is empty
+     */
+    char lineFront() const;
+
+    /**
+     * Checks if the current line is equal to a certain string.
+     *
+     * @param str the string
+     * @return true, if the line is equal to the string; false, otherwise
+     */
+    bool isLine(const char* str) const;
+
+    /**
+     * Gets the current line.
+     *
+     * @param dashesAsSpaces true, if the dashes must be replaced by spaces; false, otherwise
+     * @return the line
+     */
+    std::string line(bool dashesAsSpaces = false) const;
+
+    /**
+     * Reads the next field of the current line in place, without copying it.
+     *
+     * @param begin the pointer to the first character of the field; unchanged, if there are no more fields
+     * @param end the pointer past the last character of the field; unchanged, if there are no more fields
+     * @return true, if a field was read; false, otherwise
+     */
+    bool readField(const char*& begin, const char*& end);
+
+    /**
+     * Reads the next field of the current line as a string.
+     *
+     * @param str the string where the field is saved; unchanged, if there are no more fields
+     * @param dashesAsSpaces true, if the dashes must be replaced by spaces; false, otherwise
+     * @return true, if a field was read; false, otherwise
+     */
+    bool read(std::string& str, bool dashesAsSpaces = false);
+
+    /**
+     * Reads the next field of the current line as an unsigned integer.
+     *
+     * @param n the integer where the field is saved; unchanged, if the field isn't a valid integer
+     * @return true, if a valid field was read; false, otherwise
+     */
+    bool read(unsigned long& n);
+
+    /**
+     * Reads the next field of the current line as an unsigned integer.
+     *
+     * @param n the integer where the field is saved; unchanged, if the field isn't a valid integer
+     * @return true, if a valid field was read; false, otherwise
+     */
+    bool read(unsigned& n);
+
+    /**
+     * Reads the next field of the current line as an integer.
+     *
+     * @param n the integer where the field is saved; unchanged, if the field isn't a valid integer
+     * @return true, if a valid field was read; false, otherwise
+     */
+    bool read(int& n);
+
+    /**
+     * Reads the next field of the current line as a float.
+     *
+     * @param n the float where the field is saved; unchanged, if the field isn't a valid float
+     * @return true, if a valid field was read; false, otherwise
+     */
+    bool read(float& n);
+
+private:
+    /**
+     * Creates a new FileReader object over a part of the buffer of another one.
+     *
+     * @param begin the pointer to the first character of the part
+     * @param end the pointer past the last character of the part
+     */
+    FileReader(const char* begin, const char* end);
+
+    /**
+     * Moves to the next field of the current line.
+     *
+     * @param begin the pointer to the first character of the field
+     * @param end the pointer past the last character of the field
+     * @return true, if there was another field; false, otherwise
+     */
+    bool nextField(const char*& begin, const char*& end);
+
+    /**
+     * Parses the next field of the current line as an unsigned integer.
+     *
+     * @param n the integer where the field is saved
+     * @param negative whether the field started with a minus sign
+     * @return true, if a valid field was read; false, otherwise
+     */
+    bool readInteger(unsigned long& n, bool& negative);
+
+    /**
+     * The contents of the file, followed by a null character.
+     */
+    std::vector<char> _buffer;
+
+    /**
+     * The pointer past the last character which can be read.
+     */
+    const char* _end;
+
+    /**
+     * The pointer to the beginning of the next line.
+     */
+    const char* _next;
+
+    /**
+     * The pointer to the first character of the current line.
+     */
+    const char* _lineBegin;
+
+    /**
+     * The pointer past the last character of the current line.
+     */
+    const char* _lineEnd;
+
+    /**
+     * The pointer to the first character of the current line which wasn't read yet.
+     */
+    const char* _cursor;
+};
+
+#endif //FEUP_AEDA_PROJECT_FILE_READER_H
@@ -0,0 +1,105 @@
+#include "file_writer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "exception/file_exception.h"
+
+const std::size_t FileWriter::DEFAULT_BUFFER_SIZE = 1 << 16;
+
+namespace {
+    /**
+     * The maximum number of characters of a formatted number.
+     */
+    const std::size_t MAX_NUMBER_SIZE = 32;
+}
+
+FileWriter::FileWriter(const std::string &path, std::size_t bufferSize) : _path(path), _file(nullptr),
+        _buffer(bufferSize < MAX_NUMBER_SIZE ? MAX_NUMBER_SIZE : bufferSize), _size(0), _failed(false) {
+    _file = std::fopen(path.c_str(), "wb");
+    if (!_file) throw FileNotFound(path);
+}
+
+FileWriter::~FileWriter() {
+    if (!_file) return;
+    flush();
+    std::fclose(_file);
+}
+
+char *FileWriter::reserve(std::size_t size) {
+    if (_size + size > _buffer.size()) flush();
+    return _buffer.data() + _size;
+}
+
+void FileWriter::flush() {
+    if (_size && std::fwrite(_buffer.data(), 1, _size, _file) != _size) _failed = true;
+    _size = 0;
+}
+
+FileWriter &FileWriter::write(char c) {
+    *reserve(1) = c;
+    ++_size;
+    return *this;
+}
+
+FileWriter &FileWriter::write(const char *str) {
+    write(str, std::strlen(str), false);
+    return *this;
+}
+
+FileWriter &FileWriter::write(const std::string &str, bool spacesAsDashes) {
+    write(str.data(), str.size(), spacesAsDashes);
+    return *this;
+}
+
+void FileWriter::write(const char *data, std::size_t size, bool spacesAsDashes) {
+    // data larger than the buffer is written in several blocks
+    for (std::size_t written = 0; written < size; ) {
+        std::size_t blockSize = std::min(size - written, _buffer.size());
+        char* bytes = reserve(blockSize);
+        std::memcpy(bytes, data + written, blockSize);
+        if (spacesAsDashes) std::replace(bytes, bytes + blockSize, ' ', '-');
+        _size += blockSize;
+        written += blockSize;
+    }
+}
+
+FileWriter &FileWriter::write(unsigned long n) {
+    char digits[MAX_NUMBER_SIZE];
+    std::size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + n % 10);
+        n /= 10;
+    } while (n);
+
+    char* bytes = reserve(count);
+    for (std::size_t i = 0; i < count; ++i) bytes[i] = digits[count - 1 - i];
+    _size += count;
+    return *this;
+}
+
+FileWriter &FileWriter::write(int n) {
+    if (n < 0) write('-');
+    return write(n < 0 ? 0UL - static_cast<unsigned long>(n) : static_cast<unsigned long>(n));
+}
+
+FileWriter &FileWriter::write(unsigned n, unsigned width) {
+    for (unsigned long limit = 10; width > 1; --width, limit *= 10) if (n < limit) write('0');
+    return write(static_cast<unsigned long>(n));
+}
+
+FileWriter &FileWriter::write(float n) {
+    // the same as the default formatting of the streams, which keeps 6 significant digits
+    char* bytes = reserve(MAX_NUMBER_SIZE);
+    int size = std::snprintf(bytes, MAX_NUMBER_SIZE, "%g", static_cast<double>(n));
+    if (size > 0) _size += static_cast<std::size_t>(size);
+    return *this;
+}
+
+void FileWriter::close() {
+    if (!_file) return;
+    flush();
+    bool failed = _failed | (std::fclose(_file) != 0);
+    _file = nullptr;
+    if (failed) throw FileNotFound(_path);
+}
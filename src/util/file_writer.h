@@ -0,0 +1,116 @@
+#ifndef FEUP_AEDA_PROJECT_FILE_WRITER_H
+#define FEUP_AEDA_PROJECT_FILE_WRITER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * Class which formats data into a reusable memory buffer and writes it to a file in large blocks.
+ * Numbers are formatted in place, as a std::ofstream would do with its default settings.
+ */
+class FileWriter {
+public:
+    /**
+     * Creates a new FileWriter object, truncating the file.
+     *
+     * @param path the file path
+     * @param bufferSize the number of bytes which are kept in memory before being written
+     * @throws FileNotFound if the file can't be opened
+     */
+    explicit FileWriter(const std::string& path, std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /**
+     * Destructs the FileWriter object, writing what is still in memory if the file wasn't closed yet.
+     */
+    ~FileWriter();
+
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
+    FileWriter& write(char c);
+    FileWriter& write(const char* str);
+    FileWriter& write(unsigned long n);
+    FileWriter& write(int n);
+    FileWriter& write(float n);
+
+    /**
+     * Writes a string.
+     *
+     * @param str the string
+     * @param spacesAsDashes true, if the spaces must be replaced by dashes; false, otherwise
+     * @return the writer
+     */
+    FileWriter& write(const std::string& str, bool spacesAsDashes = false);
+
+    /**
+     * Writes an unsigned integer, padded on the left with zeros.
+     *
+     * @param n the integer
+     * @param width the minimum number of digits
+     * @return the writer
+     */
+    FileWriter& write(unsigned n, unsigned width);
+
+    /**
+     * Writes what is still in memory and closes the file.
+     *
+     * @throws FileNotFound if the file couldn't be written
+     */
+    void close();
+
+    /**
+     * The default number of bytes which are kept in memory before being written.
+     */
+    static const std::size_t DEFAULT_BUFFER_SIZE;
+
+private:
+    /**
+     * Makes sure there is room for a certain number of bytes on the buffer, writing it to the file if needed.
+     *
+     * @param size the number of bytes
+     * @return the pointer to the first free byte of the buffer
+     */
+    char* reserve(std::size_t size);
+
+    /**
+     * Writes a sequence of characters.
+     *
+     * @param data the pointer to the first character
+     * @param size the number of characters
+     * @param spacesAsDashes true, if the spaces must be replaced by dashes; false, otherwise
+     */
+    void write(const char* data, std::size_t size, bool spacesAsDashes);
+
+    /**
+     * Writes the buffer to the file and empties it.
+     */
+    void flush();
+
+    /**
+     * The file path.
+     */
+    std::string _path;
+
+    /**
+     * The file.
+     */
+    std::FILE* _file;
+
+    /**
+     * The buffer.
+     */
+    std::vector<char> _buffer;
+
+    /**
+     * The number of bytes used on the buffer.
+     */
+    std::size_t _size;
+
+    /**
+     * Whether a write to the file failed.
+     */
+    bool _failed;
+};
+
+#endif //FEUP_AEDA_PROJECT_FILE_WRITER_H
@@ -0,0 +1,236 @@
+#ifndef FEUP_AEDA_PROJECT_FLAT_HASH_SET_H
+#define FEUP_AEDA_PROJECT_FLAT_HASH_SET_H
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/**
+ * Hash set which keeps its elements in a single contiguous array (open addressing with linear probing).
+ * Erasing shifts the following elements of the probe sequence back, so no tombstones are left behind.
+ * The hash function must spread its bits well, since only the lowest bits are used to pick a slot.
+ *
+ * @tparam Key the element type
+ * @tparam Hash the hash function
+ * @tparam KeyEqual the equality function
+ */
+template <class Key, class Hash, class KeyEqual>
+class FlatHashSet {
+public:
+    /**
+     * Iterator over the elements of the set, in slot order. Elements cannot be changed through it.
+     */
+    class const_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Key value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Key* pointer;
+        typedef const Key& reference;
+
+        /**
+         * Creates a new iterator at a certain slot, moving forward to the first used slot.
+         *
+         * @param set the set
+         * @param slot the slot
+         */
+        const_iterator(const FlatHashSet* set = nullptr, std::size_t slot = 0) : _set(set), _slot(slot) {
+            skipUnused();
+        };
+
+        reference operator*() const { return _set->_keys[_slot]; };
+        pointer operator->() const { return &_set->_keys[_slot]; };
+        const_iterator& operator++() { ++_slot; skipUnused(); return *this; };
+        const_iterator operator++(int) { const_iterator it = *this; ++*this; return it; };
+        bool operator==(const const_iterator& rhs) const { return _set == rhs._set && _slot == rhs._slot; };
+        bool operator!=(const const_iterator& rhs) const { return !(*this == rhs); };
+
+    private:
+        /**
+         * Moves forward until a used slot or the end of the set.
+         */
+        void skipUnused() {
+            if (!_set) return;
+            while (_slot < _set->_used.size() && !_set->_used[_slot]) ++_slot;
+        };
+
+        /**
+         * The set which is being iterated.
+         */
+        const FlatHashSet* _set;
+
+        /**
+         * The current slot.
+         */
+        std::size_t _slot;
+
+        friend class FlatHashSet;
+    };
+
+    typedef const_iterator iterator;
+
+    /**
+     * Creates a new empty FlatHashSet object.
+     */
+    FlatHashSet() : _keys(), _used(), _size(0), _hash(), _equal() {};
+
+    const_iterator begin() const { return const_iterator(this, 0); };
+    const_iterator end() const { return const_iterator(this, _used.size()); };
+    std::size_t size() const { return _size; };
+    bool empty() const { return _size == 0; };
+
+    /**
+     * Finds an element equal to a certain one.
+     *
+     * @param key the element to look for
+     * @return the position of the element; end(), if it is not on the set
+     */
+    const_iterator find(const Key& key) const {
+        if (_used.empty()) return end();
+        for (std::size_t slot = firstSlot(key); _used[slot]; slot = nextSlot(slot)) {
+            if (_equal(_keys[slot], key)) return const_iterator(this, slot);
+        }
+        return end();
+    };
+
+    /**
+     * Counts the elements equal to a certain one.
+     *
+     * @param key the element to look for
+     * @return 1, if the element is on the set; 0, otherwise
+     */
+    std::size_t count(const Key& key) const {
+        return find(key) != end();
+    };
+
+    /**
+     * Inserts an element, unless there is already an equal one.
+     *
+     * @param key the element to insert
+     * @return the position of the element and whether it was inserted
+     */
+    std::pair<const_iterator, bool> insert(const Key& key) {
+        const_iterator found = find(key);
+        if (found != end()) return std::make_pair(found, false);
+        if (4 * (_size + 1) > 3 * _used.size()) rehash(_used.empty() ? 8 : 2 * _used.size());
+
+        std::size_t slot = firstSlot(key);
+        while (_used[slot]) slot = nextSlot(slot);
+        _keys[slot] = key;
+        _used[slot] = true;
+        ++_size;
+        return std::make_pair(const_iterator(this, slot), true);
+    };
+
+    /**
+     * Erases the element at a certain position.
+     *
+     * @param position the position of the element
+     */
+    void erase(const_iterator position) {
+        std::size_t hole = position._slot;
+        _used[hole] = false;
+        --_size;
+
+        // shift back the following elements which would no longer be reachable from their first slot
+        for (std::size_t slot = nextSlot(hole); _used[slot]; slot = nextSlot(slot)) {
+            std::size_t first = firstSlot(_keys[slot]);
+            bool reachable = hole <= slot ? (first > hole && first <= slot) : (first > hole || first <= slot);
+            if (reachable) continue;
+            _keys[hole] = _keys[slot];
+            _used[hole] = true;
+            _used[slot] = false;
+            hole = slot;
+        }
+    };
+
+    /**
+     * Erases the element equal to a certain one.
+     *
+     * @param key the element to erase
+     * @return the number of erased elements
+     */
+    std::size_t erase(const Key& key) {
+        const_iterator found = find(key);
+        if (found == end()) return 0;
+        erase(found);
+        return 1;
+    };
+
+    /**
+     * Erases all the elements.
+     */
+    void clear() {
+        _keys.clear();
+        _used.clear();
+        _size = 0;
+    };
+
+private:
+    /**
+     * Gets the slot where the probe sequence of an element starts.
+     *
+     * @param key the element
+     * @return the first slot
+     */
+    std::size_t firstSlot(const Key& key) const {
+        return static_cast<std::size_t>(_hash(key)) & (_used.size() - 1);
+    };
+
+    /**
+     * Gets the slot which follows another in a probe sequence.
+     *
+     * @param slot the slot
+     * @return the next slot
+     */
+    std::size_t nextSlot(std::size_t slot) const {
+        return (slot + 1) & (_used.size() - 1);
+    };
+
+    /**
+     * Moves all the elements to a new array.
+     *
+     * @param capacity the new number of slots (a power of two)
+     */
+    void rehash(std::size_t capacity) {
+        std::vector<Key> keys(capacity);
+        std::vector<bool> used(capacity, false);
+        keys.swap(_keys);
+        used.swap(_used);
+        for (std::size_t i = 0; i < used.size(); ++i) {
+            if (!used[i]) continue;
+            std::size_t slot = firstSlot(keys[i]);
+            while (_used[slot]) slot = nextSlot(slot);
+            _keys[slot] = keys[i];
+            _used[slot] = true;
+        }
+    };
+
+    /**
+     * The elements, one per slot.
+     */
+    std::vector<Key> _keys;
+
+    /**
+     * Whether each slot holds an element.
+     */
+    std::vector<bool> _used;
+
+    /**
+     * The number of elements.
+     */
+    std::size_t _size;
+
+    /**
+     * The hash function.
+     */
+    Hash _hash;
+
+    /**
+     * The equality function.
+     */
+    KeyEqual _equal;
+};
+
+#endif //FEUP_AEDA_PROJECT_FLAT_HASH_SET_H
@@ -0,0 +1,107 @@
+#include "quantile_sketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "binary_file.h"
+#include "exception/file_exception.h"
+
+QuantileSketch::QuantileSketch(std::uint32_t accuracy) : _accuracy(std::max<std::uint32_t>(accuracy, 2)), _count(0),
+        _compactions(0), _levels(1) {
+}
+
+void QuantileSketch::add(float value) {
+    _levels.front().push_back(value);
+    ++_count;
+    compress();
+}
+
+void QuantileSketch::merge(const QuantileSketch &other) {
+    if (_levels.size() < other._levels.size()) _levels.resize(other._levels.size());
+    for (std::size_t level = 0; level < other._levels.size(); ++level)
+        _levels[level].insert(_levels[level].end(), other._levels[level].begin(), other._levels[level].end());
+    _count += other._count;
+    compress();
+}
+
+std::uint64_t QuantileSketch::getCount() const {
+    return _count;
+}
+
+float QuantileSketch::getQuantile(double fraction) const {
+    std::vector<std::pair<float, std::uint64_t>> weighted;
+    for (std::size_t level = 0; level < _levels.size(); ++level)
+        for (const auto& value : _levels[level]) weighted.emplace_back(value, std::uint64_t(1) << level);
+    if (weighted.empty()) return 0;
+    std::sort(weighted.begin(), weighted.end());
+
+    const double rank = std::min(std::max(fraction, 0.0), 1.0) * static_cast<double>(_count);
+    std::uint64_t seen = 0;
+    for (const auto& value : weighted){
+        seen += value.second;
+        if (static_cast<double>(seen) >= rank) return value.first;
+    }
+    return weighted.back().first;
+}
+
+void QuantileSketch::write(BinaryWriter &file) const {
+    file.writeUInt32(_accuracy);
+    file.writeUInt64(_count);
+    file.writeUInt32(_compactions);
+    file.writeUInt32(static_cast<std::uint32_t>(_levels.size()));
+    for (const auto& level : _levels){
+        file.writeUInt32(static_cast<std::uint32_t>(level.size()));
+        for (const auto& value : level) file.writeFloat(value);
+    }
+}
+
+QuantileSketch QuantileSketch::read(BinaryReader &file) {
+    QuantileSketch sketch(file.readUInt32());
+    sketch._count = file.readUInt64();
+    sketch._compactions = file.readUInt32();
+
+    // a level can't be above the number of bits of the count
+    std::uint32_t levels = file.readUInt32();
+    if (levels == 0 || levels > 64) throw InvalidFile(file.getPath());
+    sketch._levels.resize(levels);
+    std::uint64_t weight = 0;
+    for (std::size_t level = 0; level < levels; ++level){
+        sketch._levels[level].resize(file.readUInt32());
+        for (auto& value : sketch._levels[level]) value = file.readFloat();
+        weight += sketch._levels[level].size() << level;
+    }
+    if (weight != sketch._count) throw InvalidFile(file.getPath());
+    return sketch;
+}
+
+std::size_t QuantileSketch::getCapacity(std::size_t level) const {
+    const double depth = static_cast<double>(_levels.size() - 1 - level);
+    return std::max<std::size_t>(2, static_cast<std::size_t>(std::ceil(_accuracy * std::pow(2.0 / 3.0, depth))));
+}
+
+void QuantileSketch::compress() {
+    for (;;){
+        std::size_t size = 0, capacity = 0;
+        for (std::size_t level = 0; level < _levels.size(); ++level){
+            size += _levels[level].size();
+            capacity += getCapacity(level);
+        }
+        if (size <= capacity) return;
+
+        for (std::size_t level = 0; level < _levels.size(); ++level){
+            if (_levels[level].size() < getCapacity(level)) continue;
+            if (level + 1 == _levels.size()) _levels.emplace_back();
+
+            // an odd value out stays on the level, and every other one of the rest moves up with twice the weight
+            std::vector<float>& compactor = _levels[level];
+            std::sort(compactor.begin(), compactor.end());
+            const std::size_t pairs = compactor.size() / 2;
+            const std::size_t offset = _compactions++ % 2;
+            std::vector<float>& above = _levels[level + 1];
+            for (std::size_t i = 0; i < pairs; ++i) above.push_back(compactor[2 * i + offset]);
+            compactor.erase(compactor.begin(), compactor.begin() + static_cast<std::ptrdiff_t>(2 * pairs));
+            break;
+        }
+    }
+}
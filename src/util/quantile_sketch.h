@@ -0,0 +1,111 @@
+#ifndef FEUP_AEDA_PROJECT_QUANTILE_SKETCH_H
+#define FEUP_AEDA_PROJECT_QUANTILE_SKETCH_H
+
+#include <cstdint>
+#include <vector>
+
+class BinaryWriter;
+class BinaryReader;
+
+/**
+ * Streaming sketch of the distribution of a list of values, which answers quantiles (such as the median or the 95th
+ * percentile) with a small rank error while keeping only a bounded number of values (KLL sketch). The values are kept
+ * on levels of compactors: when a level is full, it is sorted and every other value moves up to the next level, where
+ * each value stands for twice as many. Sketches can be merged, so that the sketch of a union of lists is found from
+ * the sketches of each list.
+ */
+class QuantileSketch {
+public:
+    /**
+     * Creates a new empty QuantileSketch object.
+     *
+     * @param accuracy the capacity of the top level; the rank error decreases as it grows
+     */
+    explicit QuantileSketch(std::uint32_t accuracy = DEFAULT_ACCURACY);
+
+    /**
+     * Adds a value.
+     *
+     * @param value the value
+     */
+    void add(float value);
+
+    /**
+     * Adds all the values of another sketch.
+     *
+     * @param other the other sketch
+     */
+    void merge(const QuantileSketch& other);
+
+    /**
+     * Gets the number of added values.
+     *
+     * @return the number of values
+     */
+    std::uint64_t getCount() const;
+
+    /**
+     * Gets an approximation of a quantile of the added values.
+     *
+     * @param fraction the fraction of the values which are not greater than the quantile, from 0 to 1
+     * @return the quantile; 0, if no value was added
+     */
+    float getQuantile(double fraction) const;
+
+    /**
+     * Writes the sketch.
+     *
+     * @param file the binary file
+     */
+    void write(BinaryWriter& file) const;
+
+    /**
+     * Reads a sketch.
+     *
+     * @param file the binary file
+     * @return the sketch
+     * @throws InvalidFile if the sketch is corrupted
+     */
+    static QuantileSketch read(BinaryReader& file);
+
+    /**
+     * The default capacity of the top level, which keeps the rank error around 1%.
+     */
+    static const std::uint32_t DEFAULT_ACCURACY = 200;
+
+private:
+    /**
+     * Gets the capacity of a level, which decreases geometrically from the top level down.
+     *
+     * @param level the level
+     * @return the capacity
+     */
+    std::size_t getCapacity(std::size_t level) const;
+
+    /**
+     * Compacts the lowest full level, until the number of kept values is within the capacity of the sketch.
+     */
+    void compress();
+
+    /**
+     * The capacity of the top level.
+     */
+    std::uint32_t _accuracy;
+
+    /**
+     * The number of added values.
+     */
+    std::uint64_t _count;
+
+    /**
+     * The number of compactions so far, whose parity decides which half of a level moves up.
+     */
+    std::uint32_t _compactions;
+
+    /**
+     * The values kept on each level; a value on level h stands for 2^h added values.
+     */
+    std::vector<std::vector<float>> _levels;
+};
+
+#endif //FEUP_AEDA_PROJECT_QUANTILE_SKETCH_H
@@ -0,0 +1,116 @@
+#ifndef FEUP_AEDA_PROJECT_SMALL_FLAT_MAP_H
+#define FEUP_AEDA_PROJECT_SMALL_FLAT_MAP_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * Ordered map which keeps its entries sorted in a single contiguous array. The first N entries are stored inline,
+ * inside the map object itself, so small maps do not allocate; once the map grows past N entries, all of them are
+ * moved to a heap buffer. Iterators are plain pointers and are invalidated by any insertion or removal.
+ *
+ * @tparam Key the key type
+ * @tparam T the mapped type
+ * @tparam Compare the ordering of the keys
+ * @tparam N the number of entries stored inline
+ */
+template <class Key, class T, class Compare, std::size_t N = 8>
+class SmallFlatMap {
+public:
+    typedef std::pair<Key, T> value_type;
+    typedef value_type* iterator;
+    typedef const value_type* const_iterator;
+
+    /**
+     * Creates a new empty SmallFlatMap object.
+     */
+    SmallFlatMap() : _inline(), _heap(), _size(0), _compare() {};
+
+    SmallFlatMap(const SmallFlatMap& other) = default;
+    SmallFlatMap& operator=(const SmallFlatMap& other) = default;
+
+    iterator begin() { return data(); };
+    iterator end() { return data() + _size; };
+    const_iterator begin() const { return data(); };
+    const_iterator end() const { return data() + _size; };
+    std::size_t size() const { return _size; };
+    bool empty() const { return _size == 0; };
+
+    /**
+     * Finds the entry of a key equivalent to another. The entries are scanned one by one rather than binary searched,
+     * so that the key is still found if the ordering of the stored keys has changed since they were inserted.
+     *
+     * @param key the key
+     * @return iterator to the entry; end(), if there is no such key
+     */
+    iterator find(const Key& key) {
+        return std::find_if(begin(), end(), [this, &key](const value_type& entry) { return equivalent(entry.first, key); });
+    };
+
+    const_iterator find(const Key& key) const {
+        return std::find_if(begin(), end(), [this, &key](const value_type& entry) { return equivalent(entry.first, key); });
+    };
+
+    /**
+     * Inserts a new entry at its sorted position. The key must not be on the map.
+     *
+     * @param key the key
+     * @param value the mapped value
+     * @return iterator to the inserted entry
+     */
+    iterator insert(const Key& key, const T& value) {
+        std::size_t position = std::lower_bound(begin(), end(), key,
+            [this](const value_type& entry, const Key& k) { return _compare(entry.first, k); }) - begin();
+
+        if (_size == N && _heap.empty()) _heap.assign(_inline.begin(), _inline.end());
+        if (_heap.empty()){
+            std::copy_backward(begin() + position, end(), end() + 1);
+            _inline[position] = value_type(key, value);
+        }
+        else _heap.insert(_heap.begin() + position, value_type(key, value));
+        ++_size;
+        return begin() + position;
+    };
+
+    /**
+     * Removes an entry, keeping the remaining ones sorted.
+     *
+     * @param position iterator to the entry
+     */
+    void erase(const_iterator position) {
+        std::size_t index = position - begin();
+        if (_heap.empty()) std::copy(begin() + index + 1, end(), begin() + index);
+        else _heap.erase(_heap.begin() + index);
+        --_size;
+    };
+
+private:
+    bool equivalent(const Key& k1, const Key& k2) const { return !_compare(k1, k2) && !_compare(k2, k1); };
+    value_type* data() { return _heap.empty() ? _inline.data() : _heap.data(); };
+    const value_type* data() const { return _heap.empty() ? _inline.data() : _heap.data(); };
+
+    /**
+     * The inline entries, used while the map has at most N entries.
+     */
+    std::array<value_type, N> _inline;
+
+    /**
+     * The heap entries, used once the map has grown past N entries.
+     */
+    std::vector<value_type> _heap;
+
+    /**
+     * The number of entries.
+     */
+    std::size_t _size;
+
+    /**
+     * The ordering of the keys.
+     */
+    Compare _compare;
+};
+
+#endif //FEUP_AEDA_PROJECT_SMALL_FLAT_MAP_H
@@ -1,5 +1,8 @@
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <sstream>
+#include <thread>
 #include "util.h"
 
 bool util::isdigit(const std::string &str, bool acceptFloat) {
@@ -78,3 +81,53 @@ void util::stripCarriageReturn(std::string& line){
     line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
 }
 
+
+std::uint64_t util::hash(std::uint64_t key) {
+    // finalizer of MurmurHash3
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+std::uint64_t util::hash(const char* data, std::size_t size) {
+    std::uint64_t hashValue = 0xcbf29ce484222325ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        hashValue ^= static_cast<unsigned char>(data[i]);
+        hashValue *= 0x100000001b3ULL;
+    }
+    return hash(hashValue);
+}
+
+std::uint64_t util::hash(const std::string& str) {
+    return hash(str.data(), str.size());
+}
+
+void util::runInParallel(const std::vector<std::function<void()>>& tasks, unsigned threads) {
+    if (threads <= 1 || tasks.size() <= 1) {
+        for (const auto& task : tasks) task();
+        return;
+    }
+
+    std::atomic<std::size_t> next(0);
+    std::vector<std::exception_ptr> errors(tasks.size());
+    auto run = [&]() {
+        for (std::size_t i = next++; i < tasks.size(); i = next++) {
+            try {
+                tasks[i]();
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < std::min<std::size_t>(threads, tasks.size()); ++i) workers.emplace_back(run);
+    run();
+    for (auto& worker : workers) worker.join();
+
+    for (const auto& error : errors) if (error) std::rethrow_exception(error);
+}
@@ -1,6 +1,8 @@
 #ifndef FEUP_AEDA_PROJECT_UTIL_H
 #define FEUP_AEDA_PROJECT_UTIL_H
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <iostream>
 #include <iomanip>
@@ -135,6 +137,41 @@ namespace util {
      * @param line - string to be manipulated.
      */
     void stripCarriageReturn(std::string& line);
+
+    /**
+     * Hashes a 64-bit integer, so that every bit of the key affects every bit of the result.
+     *
+     * @param key the integer
+     * @return the 64-bit hash
+     */
+    std::uint64_t hash(std::uint64_t key);
+
+    /**
+     * Hashes a sequence of bytes (64-bit FNV-1a, followed by the integer mix).
+     *
+     * @param data the pointer to the first byte
+     * @param size the number of bytes
+     * @return the 64-bit hash
+     */
+    std::uint64_t hash(const char* data, std::size_t size);
+
+    /**
+     * Hashes a string (64-bit FNV-1a, followed by the integer mix).
+     *
+     * @param str the string
+     * @return the 64-bit hash
+     */
+    std::uint64_t hash(const std::string& str);
+
+    /**
+     * Runs a list of independent tasks, spread over a number of threads (the calling one included).
+     * With a single thread, the tasks run in order and the first exception stops the others, as in a plain loop.
+     *
+     * @param tasks the tasks
+     * @param threads the maximum number of threads
+     * @throws the exception thrown by the first task which failed, in the order of the list
+     */
+    void runInParallel(const std::vector<std::function<void()>>& tasks, unsigned threads);
 }
 
 #endif //FEUP_AEDA_PROJECT_UTIL_H
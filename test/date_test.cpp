@@ -94,4 +94,54 @@ TEST(Date, less_than_operator){
     EXPECT_TRUE(date3 < date1);
     EXPECT_TRUE(date4 < date3);
     EXPECT_FALSE(date2 < date3);
-}
\ No newline at end of file
+}
+TEST(Date, minutes_since_epoch){
+    EXPECT_EQ(0, Date(1, 1, 1970).getMinutes());
+    EXPECT_EQ(-1, Date(31, 12, 1969, 23, 59).getMinutes());
+    EXPECT_EQ(Date(1, 1, 1970).getMinutes() + 24 * 60, Date(2, 1, 1970).getMinutes());
+
+    Date date(31, 12, 1969, 23, 59);
+    EXPECT_EQ("31/12/1969 23:59", date.getCompleteDate());
+    date.addMinutes(1);
+    EXPECT_EQ("01/01/1970 00:00", date.getCompleteDate());
+
+    Date leapDay(29, 2, 2000, 12, 0);
+    EXPECT_EQ(29, leapDay.getDay());
+    EXPECT_EQ(2, leapDay.getMonth());
+    EXPECT_EQ(2000, leapDay.getYear());
+    leapDay.addDays(-366);
+    EXPECT_EQ("28/02/1999 12:00", leapDay.getCompleteDate());
+
+    EXPECT_TRUE(Date(31, 1, 2020, 23, 59) < Date(1, 2, 2020));
+    EXPECT_THROW(Date(0, 1, 2020), InvalidDate);
+    EXPECT_THROW(Date(1, 13, 2020), InvalidDate);
+}
+
+TEST(Date, year_range){
+    EXPECT_EQ("31/12/6052 23:59", Date(31, 12, Date::MAX_YEAR, 23, 59).getCompleteDate());
+    EXPECT_EQ("01/01/0000 00:00", Date(1, 1, Date::MIN_YEAR).getCompleteDate());
+    EXPECT_TRUE(Date(1, 1, Date::MIN_YEAR) < Date(31, 12, Date::MAX_YEAR, 23, 59));
+
+    EXPECT_THROW(Date(1, 1, 9999), InvalidDate);
+    EXPECT_THROW(Date(1, 1, Date::MAX_YEAR + 1), InvalidDate);
+    EXPECT_THROW(Date(31, 12, Date::MIN_YEAR - 1, 23, 59), InvalidDate);
+
+    Date date(1, 1, 2000);
+    EXPECT_THROW(Date::parse("01/01/9999", "00:00", date), InvalidDate);
+    EXPECT_EQ("01/01/2000 00:00", date.getCompleteDate());
+}
+
+TEST(Date, parse){
+    Date date(1, 1, 2000);
+
+    EXPECT_TRUE(Date::parse("07/03/2001", "09:47", date));
+    EXPECT_EQ("07/03/2001 09:47", date.getCompleteDate());
+
+    EXPECT_FALSE(Date::parse("7/3/2001  ", "09:47", date));
+    EXPECT_FALSE(Date::parse("07-03-2001", "09:47", date));
+    EXPECT_FALSE(Date::parse("07/03/2001", "9h47m", date));
+    EXPECT_EQ("07/03/2001 09:47", date.getCompleteDate());
+
+    EXPECT_THROW(Date::parse("29/02/2019", "23:53", date), InvalidDate);
+    EXPECT_THROW(Date::parse("29/05/2020", "23:60", date), InvalidDate);
+}
@@ -275,6 +275,23 @@ TEST(Order, less_than_operator){
     EXPECT_TRUE(*order4 < *order3);
 }
 
+TEST(Order, get_priority){
+    Client client("Alfredo Simoes");
+    Worker worker("Head Office", "Beatriz Silva", 950);
+    Order order(client, worker);
+
+    EXPECT_FALSE(order.getPriority().delivered);
+    EXPECT_FLOAT_EQ(0, order.getPriority().clientEvaluation);
+    EXPECT_EQ(0, order.getPriority().clientDiscounts);
+
+    client.addEvaluation(5);
+    client.addEvaluation(2);
+    client.addDiscount();
+
+    EXPECT_FLOAT_EQ(3.5, order.getPriority().clientEvaluation);
+    EXPECT_EQ(1, order.getPriority().clientDiscounts);
+}
+
 TEST(Order, equality_operator){
     Date date(12, 1, 2012, 13, 50);
     LocationManager locationM;
@@ -312,3 +329,42 @@ TEST(Order, equality_operator){
     EXPECT_FALSE(*order3 == *order5);
     EXPECT_FALSE(*order4 == *order5);
 }
+
+TEST(Order, products_past_inline_capacity){
+    LocationManager locationM;
+    ClientManager clientM;
+    WorkerManager workerM(&locationM);
+    ProductManager productM;
+    OrderManager orderM(&productM, &clientM, &workerM, &locationM);
+
+    Client* client = clientM.add("Jose Fernandes");
+    Worker* worker = workerM.add(Order::DEFAULT_LOCATION, "Mario Rodrigues");
+    Order* order = orderM.add(client, worker);
+
+    std::vector<Product*> products;
+    for (unsigned i = 0; i < 10; ++i){
+        products.push_back(productM.addBread("Pao " + std::to_string(9 - i), 0.5f));
+        orderM.addProduct(order, products.back(), i + 1);
+    }
+
+    const OrderProducts& orderProducts = order->getProducts();
+    EXPECT_EQ(10, orderProducts.size());
+    EXPECT_EQ(&orderProducts, &order->getProducts());
+    EXPECT_TRUE(std::is_sorted(orderProducts.begin(), orderProducts.end(),
+                               [](const OrderProducts::value_type& p1, const OrderProducts::value_type& p2) {
+        return ProductSmaller()(p1.first, p2.first);
+    }));
+    EXPECT_FLOAT_EQ(0.5f * 55, order->getTotal());
+
+    orderM.addProduct(order, products.at(0), 4);
+    EXPECT_EQ(5, order->getProducts().end()[-1].second);
+    EXPECT_FLOAT_EQ(0.5f * 59, order->getTotal());
+
+    orderM.removeProduct(order, products.at(9));
+    orderM.removeProduct(order, 0ul);
+    EXPECT_EQ(8, orderProducts.size());
+    EXPECT_FLOAT_EQ(0.5f * 40, order->getTotal());
+
+    while (!orderProducts.empty()) orderM.removeProduct(order, 0ul);
+    EXPECT_FLOAT_EQ(0, order->getTotal());
+}
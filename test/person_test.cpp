@@ -387,20 +387,45 @@ TEST(Worker, remove_order_to_deliver){
 
 TEST(Worker, add_evaluation){
     Worker worker("Head Office", "Rodrigo Machado");
+    Date date(20, 3, 2021);
 
     EXPECT_FLOAT_EQ(0, worker.getMeanEvaluation());
 
-    worker.addEvaluation(4);
+    worker.addDelivery(4, 1, date);
 
     EXPECT_FLOAT_EQ(4, worker.getMeanEvaluation());
 
-    worker.addEvaluation(3);
-    worker.addEvaluation(2);
-    worker.addEvaluation(5);
+    worker.addDelivery(3, 1, date);
+    worker.addDelivery(2, 1, date);
+    worker.addDelivery(5, 1, date);
 
     EXPECT_FLOAT_EQ((float)(4+3+2+5)/4, worker.getMeanEvaluation());
 }
 
+TEST(Worker, scorecard){
+    Worker worker("Head Office", "Rodrigo Machado");
+    Date today(20, 3, 2021, 12);
+
+    worker.addDelivery(5, 10, Date(20, 3, 2021, 9));
+    worker.addDelivery(3, 4.5, Date(1, 3, 2021));
+    worker.addDelivery(1, 2, Date(18, 2, 2021)); // 30 days before the first one, on the same slot
+    worker.addDelivery(4, 8, Date(1, 1, 2021));
+    worker.addDelivery(5, 0, Date(1, 12, 2020));
+
+    const WorkerScorecard& scorecard = worker.getScorecard();
+    EXPECT_EQ(5, scorecard.getDeliveries());
+    EXPECT_FLOAT_EQ(24.5, scorecard.getRevenue());
+    EXPECT_EQ((std::array<unsigned long, 6>{0, 1, 0, 1, 1, 2}), scorecard.getHistogram());
+    EXPECT_FLOAT_EQ((float)(5+3+1+4+5)/5, worker.getMeanEvaluation());
+
+    EXPECT_EQ(2, scorecard.getRecentDeliveries(today));
+    EXPECT_FLOAT_EQ((float)(5+3)/2, scorecard.getRecentMeanEvaluation(today));
+    EXPECT_EQ(1, scorecard.getRecentDeliveries(Date(19, 3, 2021)));
+    EXPECT_FLOAT_EQ(3, scorecard.getRecentMeanEvaluation(Date(19, 3, 2021)));
+    EXPECT_EQ(0, scorecard.getRecentDeliveries(Date(1, 5, 2021)));
+    EXPECT_FLOAT_EQ(0, scorecard.getRecentMeanEvaluation(Date(1, 5, 2021)));
+}
+
 TEST(Boss, read){
     //Adelaide 3847565 adelaide adelaide123
     Boss boss("To read");
@@ -4,6 +4,10 @@
 #include "exception/file_exception.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
 
 using testing::Eq;
 
@@ -72,6 +76,38 @@ TEST(Store, get_profit){
     EXPECT_FLOAT_EQ(order1->getFinalPrice()+order2->getFinalPrice(), store.getProfit());
 }
 
+TEST(Store, running_totals){
+    Store store;
+    Client* client = store.clientManager.add("Fernando Castro");
+    Worker* worker = store.workerManager.add(Order::DEFAULT_LOCATION, "Josue Tome", 928);
+    Cake* cake = store.productManager.addCake("Bolo de chocolate", 10);
+    client->addPoints(200);
+
+    Order* order1 = store.orderManager.add(client, worker);
+    store.orderManager.addProduct(order1, cake, 10);
+    Order* order2 = store.orderManager.add(client, worker);
+    store.orderManager.addProduct(order2, cake, 1);
+    store.orderManager.remove(order2);
+
+    // the price of a delivered order does not change with the client points
+    store.orderManager.deliver(order1, 3);
+    client->resetPoints();
+    EXPECT_FALSE(order1->hasDiscount());
+    EXPECT_FLOAT_EQ(0.98f * 100, order1->getFinalPrice());
+    EXPECT_FLOAT_EQ(0.98f * 100, store.getProfit());
+
+    Order* order3 = store.orderManager.add(client, worker);
+    store.orderManager.addProduct(order3, cake, 2);
+    store.orderManager.deliver(order3, 4, false);
+
+    EXPECT_EQ(2, store.orderManager.getDeliveredCount());
+    EXPECT_EQ(7, store.orderManager.getEvaluationsSum());
+    EXPECT_FLOAT_EQ(0.98f * 100 + 20, store.getProfit());
+    EXPECT_EQ(3, store.getEvaluation());
+    EXPECT_TRUE(store.orderManager.recomputeTotals());
+    EXPECT_FLOAT_EQ(0.98f * 100 + 20, store.getProfit());
+}
+
 TEST(Store, read){
     Store store;
     std::string path = "../../test/data";
@@ -129,7 +165,7 @@ TEST(Store, read){
     EXPECT_EQ("12/12/2020 14:45", order->getRequestDate().getCompleteDate());
     EXPECT_EQ("Lisboa", order->getDeliverLocation());
 
-    std::map<Product*, unsigned int, ProductSmaller> products = store.orderManager.getAll().top().getOrder()->getProducts();
+    const OrderProducts& products = store.orderManager.getAll().top().getOrder()->getProducts();
     std::string productName = "Pao da avo", productCategory = "Big Bread";
     float productPrice = 1;
     unsigned int productQuantity = 1;
@@ -155,6 +191,7 @@ TEST(Store, read){
     EXPECT_TRUE(it != products.end());
 
     EXPECT_FLOAT_EQ(4, store.getEvaluation());
+    EXPECT_TRUE(store.orderManager.recomputeTotals());
 }
 
 TEST(Store, write){
@@ -215,6 +252,384 @@ TEST(Store, write){
     storeInit.write(path);
 }
 
+TEST(Store, snapshot){
+    std::string path = "store.snapshot";
+    Store store;
+    store.read("../../test/data");
+    store.locationManager.add("Porto");
+    Client* client = store.clientManager.add("Joao Miguel", 123823, true);
+    client->setPoints(120);
+    Worker* worker = store.workerManager.add("Porto", "Mario Cordeiro", 823823, 1200);
+    Cake* cake = store.productManager.addCake("Bolo de arroz", 1.5, CakeCategory::CRUNCHY);
+    Bread* bread = store.productManager.addBread("Pao de centeio", 0.3, false);
+    Order* order = store.orderManager.add(client, worker, "Porto", Date(23, 5, 2019, 21, 30));
+    store.orderManager.addProduct(order, cake, 2);
+    store.orderManager.addProduct(order, bread, 5);
+    store.orderManager.deliver(order, 4, false, 95);
+
+    EXPECT_EQ("Export succeeded.", store.writeSnapshot(path));
+
+    Store loaded;
+    EXPECT_EQ("Import succeeded.", loaded.readSnapshot(path));
+
+    EXPECT_EQ(store.boss.getName(), loaded.boss.getName());
+    EXPECT_EQ(store.boss.getTaxId(), loaded.boss.getTaxId());
+    EXPECT_TRUE(store.boss.getCredential() == loaded.boss.getCredential());
+    EXPECT_EQ(store.locationManager.getAll(), loaded.locationManager.getAll());
+    EXPECT_EQ(store.clientManager.getAll().size(), loaded.clientManager.getAll().size());
+    EXPECT_EQ(store.workerManager.getAll().size(), loaded.workerManager.getAll().size());
+    EXPECT_EQ(store.orderManager.getOrders().size(), loaded.orderManager.getOrders().size());
+    EXPECT_FLOAT_EQ(store.getProfit(), loaded.getProfit());
+    EXPECT_EQ(store.getEvaluation(), loaded.getEvaluation());
+
+    std::vector<Product*> products = store.productManager.getAll(), loadedProducts = loaded.productManager.getAll();
+    ASSERT_EQ(products.size(), loadedProducts.size());
+    for (unsigned long i = 0; i < products.size(); ++i){
+        EXPECT_EQ(products.at(i)->getName(), loadedProducts.at(i)->getName());
+        EXPECT_EQ(products.at(i)->getCategory(), loadedProducts.at(i)->getCategory());
+        EXPECT_FLOAT_EQ(products.at(i)->getPrice(), loadedProducts.at(i)->getPrice());
+        EXPECT_EQ(products.at(i)->getTimesIncluded(), loadedProducts.at(i)->getTimesIncluded());
+    }
+
+    Client* loadedClient = loaded.clientManager.getClient(123823);
+    EXPECT_EQ("Joao Miguel", loadedClient->getName());
+    EXPECT_TRUE(loadedClient->isPremium());
+    EXPECT_EQ(120, loadedClient->getPoints());
+
+    Worker* loadedWorker = loaded.workerManager.getWorker(823823);
+    EXPECT_EQ("Porto", loadedWorker->getLocation());
+    EXPECT_FLOAT_EQ(1200, loadedWorker->getSalary());
+
+    const OrderQueue& loadedOrders = loaded.orderManager.getOrders(loadedClient);
+    ASSERT_EQ(1, loadedOrders.size());
+    Order* loadedOrder = loadedOrders.begin()->getOrder();
+    EXPECT_EQ(loadedWorker, loadedOrder->getWorker());
+    EXPECT_EQ("23/05/2019 21:30", loadedOrder->getRequestDate().getCompleteDate());
+    EXPECT_TRUE(loadedOrder->wasDelivered());
+    EXPECT_EQ(4, loadedOrder->getClientEvaluation());
+    EXPECT_EQ("23/05/2019 23:05", loadedOrder->getDeliverDate().getCompleteDate());
+    EXPECT_EQ(1, loadedWorker->getScorecard().getRecentDeliveries(Date(24, 5, 2019)));
+    EXPECT_FLOAT_EQ(order->getFinalPrice(), loadedOrder->getFinalPrice());
+    EXPECT_EQ(2, loadedOrder->getProducts().size());
+
+    const DeliverySketches& sketches = store.orderManager.getSketches(loadedWorker->getLocationHandle());
+    const DeliverySketches& loadedSketches = loaded.orderManager.getSketches(loadedWorker);
+    EXPECT_EQ(sketches.value.getCount(), loaded.orderManager.getSketches(Location("Porto")).value.getCount());
+    EXPECT_EQ(1, loadedSketches.latency.getCount());
+    EXPECT_FLOAT_EQ(95, loadedSketches.latency.getQuantile(0.5));
+    EXPECT_FLOAT_EQ(order->getFinalPrice(), loadedSketches.value.getQuantile(0.5));
+
+    // a single changed byte is detected by the checksum
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-1, std::ios::end);
+        char last = static_cast<char>(file.get());
+        file.seekp(-1, std::ios::end);
+        file.put(static_cast<char>(last ^ 1));
+    }
+    Store corrupted;
+    EXPECT_NE(std::string::npos, corrupted.readSnapshot(path).find("Import failed!"));
+    EXPECT_TRUE(corrupted.clientManager.getAll().empty());
+    std::remove(path.c_str());
+
+    EXPECT_NE(std::string::npos, corrupted.readSnapshot(path).find("Import failed!"));
+}
+
+TEST(Store, archive_orders){
+    std::string path = "orders.archive";
+    Store store;
+    store.locationManager.add("Porto");
+    Client* client = store.clientManager.add("Joao Miguel", 123823);
+    Client* other = store.clientManager.add("Ana Castro", 323823);
+    Worker* worker = store.workerManager.add("Porto", "Mario Cordeiro", 823823);
+    Cake* cake = store.productManager.addCake("Bolo de arroz", 1.5);
+    client->setPoints(200);
+    Order* old = store.orderManager.add(client, worker, "Porto", Date(23, 5, 2019, 21, 30));
+    store.orderManager.addProduct(old, cake, 2);
+    store.orderManager.deliver(old, 4, false);
+    Order* otherOld = store.orderManager.add(other, worker, "Porto", Date(2, 6, 2019, 10, 0));
+    store.orderManager.addProduct(otherOld, cake);
+    store.orderManager.deliver(otherOld, 2, false);
+    Order* recent = store.orderManager.add(client, worker, "Porto", Date(10, 3, 2021, 12, 0));
+    store.orderManager.addProduct(recent, cake);
+    store.orderManager.deliver(recent, 5, false);
+    store.orderManager.add(client, worker, "Porto", Date(11, 3, 2021, 12, 0));
+
+    float profit = store.getProfit();
+    int evaluation = store.getEvaluation();
+    EXPECT_THROW(store.archiveOrders(Date(1, 1, 2020)), std::logic_error);
+
+    store.orderManager.openArchive(path);
+    EXPECT_EQ(2, store.archiveOrders(Date(1, 1, 2020)));
+    EXPECT_EQ(0, store.archiveOrders(Date(1, 1, 2020)));
+    EXPECT_EQ(2, store.orderManager.getOrders().size());
+    EXPECT_TRUE(store.orderManager.getOrders(other).empty());
+    EXPECT_FLOAT_EQ(profit, store.getProfit());
+    EXPECT_EQ(evaluation, store.getEvaluation());
+
+    std::vector<ArchivedOrder> archived = store.orderManager.getArchive().get(client);
+    ASSERT_EQ(1, archived.size());
+    EXPECT_EQ("Mario Cordeiro", archived.at(0).workerName);
+    EXPECT_EQ("23/05/2019 21:30", archived.at(0).requestDate.getCompleteDate());
+    EXPECT_EQ("23/05/2019 22:00", archived.at(0).deliverDate.getCompleteDate());
+    EXPECT_EQ(4, archived.at(0).clientEvaluation);
+    ASSERT_EQ(1, archived.at(0).products.size());
+    EXPECT_EQ(2, std::get<2>(archived.at(0).products.at(0)));
+    EXPECT_EQ(2, store.orderManager.getArchive().get(nullptr, worker).size());
+
+    std::ostringstream os;
+    EXPECT_TRUE(store.orderManager.print(os, other));
+    EXPECT_NE(std::string::npos, os.str().find("Archived orders:"));
+
+    // only the summaries are loaded when the archive is opened again
+    OrderArchive reopened;
+    reopened.open(path);
+    EXPECT_EQ(2, reopened.getSize());
+    EXPECT_EQ(6, reopened.getEvaluationsSum());
+    EXPECT_FLOAT_EQ(store.orderManager.getArchive().getProfit(), reopened.getProfit());
+
+    // the evaluations of the archived orders are added back to their clients and workers
+    ASSERT_EQ("Export succeeded.", store.writeSnapshot("archive.snapshot"));
+    Store loaded;
+    ASSERT_EQ("Import succeeded.", loaded.readSnapshot("archive.snapshot"));
+    EXPECT_EQ("Archive opened.", loaded.openArchive(path));
+    EXPECT_FLOAT_EQ(profit, loaded.getProfit());
+    EXPECT_EQ(evaluation, loaded.getEvaluation());
+    Client* loadedClient = loaded.clientManager.getClient(123823);
+    EXPECT_FLOAT_EQ(client->getMeanEvaluation(), loadedClient->getMeanEvaluation());
+    EXPECT_EQ(2, client->getNumDiscounts());
+    EXPECT_EQ(client->getNumDiscounts(), loadedClient->getNumDiscounts());
+    EXPECT_FLOAT_EQ(other->getMeanEvaluation(), loaded.clientManager.getClient(323823)->getMeanEvaluation());
+    const WorkerScorecard& scorecard = worker->getScorecard();
+    const WorkerScorecard& loadedScorecard = loaded.workerManager.getWorker(823823)->getScorecard();
+    EXPECT_EQ(3, loadedScorecard.getDeliveries());
+    EXPECT_FLOAT_EQ(scorecard.getRevenue(), loadedScorecard.getRevenue());
+    EXPECT_EQ(scorecard.getHistogram(), loadedScorecard.getHistogram());
+    EXPECT_EQ(2, loadedScorecard.getRecentDeliveries(Date(10, 6, 2019)));
+
+    // the sketches saved on the snapshot already hold the archived orders, the ones rebuilt from the text files don't
+    EXPECT_EQ(3, loaded.orderManager.getSketches(Location("Porto")).value.getCount());
+    EXPECT_EQ(3, loaded.orderManager.getSketches(loaded.workerManager.getWorker(823823)).latency.getCount());
+    ASSERT_EQ("Export succeeded.", store.write("."));
+    Store imported;
+    ASSERT_EQ("Import succeeded.", imported.read("."));
+    EXPECT_EQ(1, imported.orderManager.getSketches(Location("Porto")).value.getCount());
+    EXPECT_EQ("Archive opened.", imported.openArchive(path));
+    EXPECT_EQ(3, imported.orderManager.getSketches(Location("Porto")).value.getCount());
+    EXPECT_EQ(3, imported.orderManager.getSketches(imported.workerManager.getWorker(823823)).latency.getCount());
+    EXPECT_FLOAT_EQ(store.orderManager.getSketches().value.getQuantile(0.5),
+                    imported.orderManager.getSketches().value.getQuantile(0.5));
+
+    std::remove("archive.snapshot");
+    std::remove((path + ".0").c_str());
+    for (const char* file : {"boss.txt", "locations.txt", "products.txt", "clients.txt", "workers.txt", "orders.txt"})
+        std::remove(file);
+}
+
+TEST(Store, recover_archived_orders){
+    std::string snapshotPath = "archived.snapshot", journalPath = "archived.journal", path = "recovered.archive";
+    float profit;
+    int evaluation;
+    {
+        Store store;
+        ASSERT_EQ("Recovery succeeded.", store.recover(snapshotPath, journalPath));
+        ASSERT_EQ("Archive opened.", store.openArchive(path));
+        store.locationManager.add("Porto");
+        Client* client = store.clientManager.add("Joao Miguel", 123823);
+        Worker* worker = store.workerManager.add("Porto", "Mario Cordeiro", 823823);
+        Cake* cake = store.productManager.addCake("Bolo de arroz", 1.5);
+        Order* old = store.orderManager.add(client, worker, "Porto", Date(23, 5, 2019, 21, 30));
+        store.orderManager.addProduct(old, cake, 2);
+        store.orderManager.deliver(old, 4, false);
+        Order* recent = store.orderManager.add(client, worker, "Porto", Date(10, 3, 2021, 12, 0));
+        store.orderManager.addProduct(recent, cake);
+        store.orderManager.deliver(recent, 2, false);
+        ASSERT_EQ("Checkpoint succeeded.", store.checkpoint());
+        profit = store.getProfit();
+        evaluation = store.getEvaluation();
+
+        // the store stops after the segment is saved and before the checkpoint
+        EXPECT_EQ(1, store.orderManager.archive(Date(1, 1, 2020)));
+        store.syncJournal();
+    }
+
+    auto check = [&](Store& recovered){
+        EXPECT_EQ(1, recovered.orderManager.getOrders().size());
+        EXPECT_EQ(1, recovered.orderManager.getArchive().getSize());
+        EXPECT_FLOAT_EQ(profit, recovered.getProfit());
+        EXPECT_EQ(evaluation, recovered.getEvaluation());
+        Client* client = recovered.clientManager.getClient(123823);
+        EXPECT_FLOAT_EQ(3, client->getMeanEvaluation());
+        const WorkerScorecard& scorecard = recovered.workerManager.getWorker(823823)->getScorecard();
+        EXPECT_EQ(2, scorecard.getDeliveries());
+        EXPECT_EQ(1, scorecard.getHistogram().at(4));
+    };
+    {
+        Store recovered;
+        ASSERT_EQ("Recovery succeeded.", recovered.recover(snapshotPath, journalPath));
+        EXPECT_EQ(2, recovered.orderManager.getOrders().size());
+        ASSERT_EQ("Archive opened.", recovered.openArchive(path));
+        check(recovered);
+    }
+    // opening the archive saved the store without the archived order
+    Store recovered;
+    ASSERT_EQ("Recovery succeeded.", recovered.recover(snapshotPath, journalPath));
+    EXPECT_EQ(1, recovered.orderManager.getOrders().size());
+    ASSERT_EQ("Archive opened.", recovered.openArchive(path));
+    check(recovered);
+
+    std::remove(snapshotPath.c_str());
+    std::remove(journalPath.c_str());
+    std::remove((path + ".0").c_str());
+}
+
+TEST(Store, read_parallel){
+    Store original;
+    ASSERT_EQ("Import succeeded.", original.read("../../test/data"));
+    original.locationManager.add("Braga");
+    original.locationManager.add("Porto");
+    std::vector<Product*> products = original.productManager.getAll();
+    for (unsigned long i = 0; i < 40; ++i){
+        Client* client = original.clientManager.add("Cliente " + std::to_string(i), 300000 + i, i % 3 == 0);
+        Worker* worker = original.workerManager.add(i % 2 ? "Braga" : "Porto", "Trabalhador " + std::to_string(i), 400000 + i);
+        for (int j = 0; j < 10; ++j){
+            Order* order = original.orderManager.add(client, worker, "Braga", Date(1 + j, 1 + i % 12, 2020, 12, 30));
+            original.orderManager.addProduct(order, products.at((i + j) % products.size()), 1 + j % 3);
+            if (j % 2) original.orderManager.deliver(order, j % 6, false);
+        }
+    }
+    ASSERT_EQ("Export succeeded.", original.write("."));
+
+    Store sequential, parallel;
+    EXPECT_EQ("Import succeeded.", sequential.read("."));
+    EXPECT_EQ("Import succeeded.", parallel.read(".", 4));
+    EXPECT_EQ(original.orderManager.getOrders().size(), parallel.orderManager.getOrders().size());
+
+    // the snapshots hold the whole state of the store, in the order everything was added
+    ASSERT_EQ("Export succeeded.", sequential.writeSnapshot("sequential.snapshot"));
+    ASSERT_EQ("Export succeeded.", parallel.writeSnapshot("parallel.snapshot"));
+    std::ifstream sequentialFile("sequential.snapshot", std::ios::binary), parallelFile("parallel.snapshot", std::ios::binary);
+    std::string sequentialData((std::istreambuf_iterator<char>(sequentialFile)), std::istreambuf_iterator<char>());
+    std::string parallelData((std::istreambuf_iterator<char>(parallelFile)), std::istreambuf_iterator<char>());
+    EXPECT_FALSE(sequentialData.empty());
+    EXPECT_EQ(sequentialData, parallelData);
+
+    for (const char* file : {"sequential.snapshot", "parallel.snapshot", "boss.txt", "locations.txt", "products.txt",
+                             "clients.txt", "workers.txt", "orders.txt"})
+        std::remove(file);
+}
+
+TEST(Store, recover_from_journal){
+    std::string snapshotPath = "recover.snapshot", journalPath = "recover.journal", deliverDate;
+    {
+        Store store;
+        EXPECT_EQ("Recovery succeeded.", store.recover(snapshotPath, journalPath, 4));
+        store.locationManager.add("Porto");
+        Client* client = store.clientManager.add("Joao Miguel", 123823, true);
+        Worker* worker = store.workerManager.add("Porto", "Mario Cordeiro", 823823, 1000);
+        Cake* cake = store.productManager.addCake("Bolo de arroz", 1.5, CakeCategory::CRUNCHY);
+        Order* order = store.orderManager.add(client, worker, "Porto", Date(23, 5, 2019, 21, 30));
+        store.orderManager.addProduct(order, cake, 2);
+        store.orderManager.deliver(order, 4, false, 0);
+        deliverDate = order->getDeliverDate().getCompleteDate();
+        store.clientManager.setTaxID(client, 223823);
+        store.workerManager.raiseSalary(10);
+        EXPECT_EQ(1, store.orderManager.getOrders().size());
+    }
+
+    Store recovered;
+    EXPECT_EQ("Recovery succeeded.", recovered.recover(snapshotPath, journalPath));
+    EXPECT_TRUE(recovered.locationManager.has("Porto"));
+    EXPECT_THROW(recovered.clientManager.getClient(123823), PersonDoesNotExist);
+    Client* client = recovered.clientManager.getClient(223823);
+    EXPECT_TRUE(client->isPremium());
+    Worker* worker = recovered.workerManager.getWorker(823823);
+    EXPECT_FLOAT_EQ(1100, worker->getSalary());
+    EXPECT_EQ(Cake::categoryStr[4], recovered.productManager.get("Bolo de arroz", 1.5)->getCategory());
+
+    const OrderQueue& orders = recovered.orderManager.getOrders(client);
+    ASSERT_EQ(1, orders.size());
+    Order* order = orders.begin()->getOrder();
+    EXPECT_EQ(worker, order->getWorker());
+    EXPECT_TRUE(order->wasDelivered());
+    EXPECT_EQ(4, order->getClientEvaluation());
+    EXPECT_EQ(deliverDate, order->getDeliverDate().getCompleteDate());
+    EXPECT_FLOAT_EQ(3, order->getTotal());
+
+    // after a checkpoint, the journal of the previous generation is already part of the snapshot
+    recovered.locationManager.add("Braga");
+    EXPECT_EQ("Checkpoint succeeded.", recovered.checkpoint());
+    recovered.locationManager.add("Faro");
+    recovered.syncJournal();
+
+    Store restarted;
+    EXPECT_EQ("Recovery succeeded.", restarted.recover(snapshotPath, journalPath));
+    EXPECT_TRUE(restarted.locationManager.has("Braga"));
+    EXPECT_TRUE(restarted.locationManager.has("Faro"));
+    EXPECT_EQ(1, restarted.orderManager.getOrders().size());
+
+    Store notRecovered;
+    EXPECT_NE(std::string::npos, notRecovered.checkpoint().find("Checkpoint failed!"));
+
+    std::remove(snapshotPath.c_str());
+    std::remove(journalPath.c_str());
+}
+
+TEST(Store, recover_renamed_persons){
+    std::string snapshotPath = "renamed.snapshot", journalPath = "renamed.journal";
+    {
+        Store store;
+        EXPECT_EQ("Recovery succeeded.", store.recover(snapshotPath, journalPath));
+        store.locationManager.add("Porto");
+        Client* client = store.clientManager.add("Joao Miguel");
+        Client* other = store.clientManager.add("Ana Castro");
+        Worker* worker = store.workerManager.add("Porto", "Mario Cordeiro");
+        store.clientManager.setName(client, "Joao Miguel Sousa");
+        store.clientManager.setPremium(client, true);
+        store.workerManager.setName(worker, "Mario Cordeiro Costa");
+        EXPECT_THROW(store.clientManager.setName(other, "Joao Miguel Sousa"), PersonAlreadyExists);
+        EXPECT_EQ("Ana Castro", other->getName());
+        store.orderManager.add(client, worker, "Porto", Date(23, 5, 2019, 21, 30));
+    }
+
+    Store recovered;
+    EXPECT_EQ("Recovery succeeded.", recovered.recover(snapshotPath, journalPath));
+    ASSERT_EQ(2, recovered.clientManager.getAll().size());
+    Client* client = *recovered.clientManager.getAll().rbegin();
+    EXPECT_EQ("Joao Miguel Sousa", client->getName());
+    EXPECT_TRUE(client->isPremium());
+    ASSERT_EQ(1, recovered.workerManager.getAll().size());
+    Worker* worker = *recovered.workerManager.getAll().begin();
+    EXPECT_EQ("Mario Cordeiro Costa", worker->getName());
+    ASSERT_EQ(1, recovered.orderManager.getOrders(client).size());
+    EXPECT_EQ(worker, recovered.orderManager.getOrders(client).begin()->getOrder()->getWorker());
+
+    std::remove(snapshotPath.c_str());
+    std::remove(journalPath.c_str());
+}
+
+TEST(Store, recover_boss_changes){
+    std::string snapshotPath = "boss.snapshot", journalPath = "boss.journal";
+    {
+        Store store;
+        EXPECT_EQ("Recovery succeeded.", store.recover(snapshotPath, journalPath));
+        store.setBossName("Fernando Castro");
+        store.setBossTaxID(123456789);
+        store.setBossCredential({"fernando", "bolos"});
+        EXPECT_THROW(store.setBossCredential({"exit", "bolos"}), InvalidCredential);
+    }
+
+    Store recovered;
+    EXPECT_EQ("Recovery succeeded.", recovered.recover(snapshotPath, journalPath));
+    EXPECT_EQ("Fernando Castro", recovered.boss.getName());
+    EXPECT_EQ(123456789, recovered.boss.getTaxId());
+    EXPECT_EQ("fernando", recovered.boss.getCredential().username);
+    EXPECT_EQ("bolos", recovered.boss.getCredential().password);
+
+    std::remove(snapshotPath.c_str());
+    std::remove(journalPath.c_str());
+}
+
 TEST(ClientManager, has_client){
     ClientManager clientM;
 
@@ -256,6 +671,37 @@ TEST(ClientManager, get_client_by_taxID){
     EXPECT_THROW(clientM.getClient(3244313), PersonDoesNotExist);
 }
 
+TEST(ClientManager, set_taxID_and_credential){
+    ClientManager clientM;
+    Client* client1 = clientM.add("Alvaro Campos", 123812321);
+    Client* client2 = clientM.add("Henrique Vaz", 495483123);
+    Client outsider("Sofia Rebelo", 111111111);
+
+    clientM.setTaxID(client1, 999111222);
+
+    EXPECT_EQ(999111222, client1->getTaxId());
+    EXPECT_EQ(client1, clientM.getClient(999111222));
+    EXPECT_THROW(clientM.getClient(123812321), PersonDoesNotExist);
+    EXPECT_TRUE(clientM.has(client1));
+    EXPECT_THROW(clientM.setTaxID(client1, 495483123), PersonAlreadyExists);
+    EXPECT_EQ(client1, clientM.getClient(999111222));
+    EXPECT_THROW(clientM.setTaxID(&outsider, 222222222), PersonDoesNotExist);
+
+    EXPECT_EQ(2, clientM.getByUsername(Client::DEFAULT_USERNAME).size());
+
+    clientM.setCredential(client2, {"henrique", "vaz"});
+
+    EXPECT_EQ(1, clientM.getByUsername(Client::DEFAULT_USERNAME).size());
+    ASSERT_EQ(1, clientM.getByUsername("henrique").size());
+    EXPECT_EQ(client2, clientM.getByUsername("henrique").at(0));
+
+    clientM.remove(client2);
+
+    EXPECT_TRUE(clientM.getByUsername("henrique").empty());
+    EXPECT_THROW(clientM.getClient(495483123), PersonDoesNotExist);
+    delete client2;
+}
+
 TEST(ClientManager, add_client){
     unsigned position = 0;
     Client client1("Rodrigo Pereira");
@@ -430,6 +876,28 @@ TEST(WorkerManager, get_worker_by_position){
     EXPECT_THROW(workerM.get(++position), InvalidPersonPosition);
 }
 
+TEST(WorkerManager, best_workers){
+    LocationManager locationM;
+    locationM.add("Porto");
+    WorkerManager workerM(&locationM);
+    Date today(10, 6, 2021);
+
+    Worker* worker1 = workerM.add("Porto", "Ana Faria");
+    Worker* worker2 = workerM.add("Porto", "Marco Moreira");
+    Worker* worker3 = workerM.add("Porto", "Joao Lopes");
+    Worker* worker4 = workerM.add("Porto", "Sofia Rebelo");
+    worker1->addDelivery(4, 5, Date(9, 6, 2021));
+    worker2->addDelivery(5, 5, Date(1, 6, 2021));
+    worker2->addDelivery(3, 5, Date(2, 6, 2021));
+    worker3->addDelivery(5, 5, Date(1, 1, 2021));
+    worker4->addDelivery(3, 5, Date(10, 6, 2021));
+    worker4->addDelivery(5, 5, Date(10, 6, 2021));
+
+    EXPECT_EQ((std::vector<Worker*>{worker2, worker4, worker1}), workerM.getBestWorkers(3, today));
+    EXPECT_EQ((std::vector<Worker*>{worker2, worker4, worker1, worker3}), workerM.getBestWorkers(10, today));
+    EXPECT_TRUE(workerM.getBestWorkers(0, today).empty());
+}
+
 TEST(WorkerManager, get_workers_by_location){
     std::string location = "Braga";
     LocationManager locationM;
@@ -439,7 +907,7 @@ TEST(WorkerManager, get_workers_by_location){
     Worker* worker1 = workerM.add(location, "Ana Faria");
     Worker* worker2 = workerM.add(location, "Marco Moreira");
     Worker* worker3 = workerM.add(Order::DEFAULT_LOCATION, "Joao Lopes");
-    tabHWorker workers = workerM.getByLocation(location);
+    tabHWorker workers = workerM.getByLocation(Location(location));
     auto it = workers.begin();
 
     EXPECT_EQ(2, workers.size());
@@ -466,6 +934,27 @@ TEST(WorkerManager, get_worker_by_taxID){
     EXPECT_THROW(workerM.getWorker(8984313), PersonDoesNotExist);
 }
 
+TEST(WorkerManager, set_taxID_and_credential){
+    LocationManager locationM;
+    WorkerManager workerM(&locationM);
+    Worker* worker1 = workerM.add(Order::DEFAULT_LOCATION, "Alvaro Campos", 123812321);
+    Worker* worker2 = workerM.add(Order::DEFAULT_LOCATION, "Henrique Vaz", 495483123);
+
+    workerM.setTaxID(worker1, 999111222);
+
+    EXPECT_EQ(worker1, workerM.getWorker(999111222));
+    EXPECT_THROW(workerM.getWorker(123812321), PersonDoesNotExist);
+    EXPECT_TRUE(workerM.has(worker1));
+    EXPECT_EQ(2, workerM.getAll().size());
+    EXPECT_THROW(workerM.setTaxID(worker1, 495483123), PersonAlreadyExists);
+
+    workerM.setCredential(worker2, {"henrique", "vaz"});
+
+    EXPECT_EQ(1, workerM.getByUsername(Worker::DEFAULT_USERNAME).size());
+    ASSERT_EQ(1, workerM.getByUsername("henrique").size());
+    EXPECT_EQ(worker2, workerM.getByUsername("henrique").at(0));
+}
+
 TEST(WorkerManager, get_less_busy_worker){
     Store store("Aeda");
     LocationManager locationM;
@@ -474,7 +963,7 @@ TEST(WorkerManager, get_less_busy_worker){
     WorkerManager workerM(&locationM);
     OrderManager orderM(&productM, &clientM, &workerM, &locationM);
 
-    EXPECT_THROW(workerM.getLessBusyWorker(Order::DEFAULT_LOCATION), StoreHasNoWorkers);
+    EXPECT_THROW(workerM.getLessBusyWorker(Location(Order::DEFAULT_LOCATION)), StoreHasNoWorkers);
 
     Client* client1 = clientM.add("Ricardo Macedo");
     Client* client2 = clientM.add("Joana Moreira");
@@ -483,19 +972,19 @@ TEST(WorkerManager, get_less_busy_worker){
 
     EXPECT_EQ(0, worker1->getUndeliveredOrders());
     EXPECT_EQ(0, worker2->getUndeliveredOrders());
-    EXPECT_TRUE(*worker2 == *(workerM.getLessBusyWorker("Head Office")));
+    EXPECT_TRUE(*worker2 == *(workerM.getLessBusyWorker(Location("Head Office"))));
 
     Order* order1 = orderM.add(client1);
 
     EXPECT_EQ(1,worker2->getUndeliveredOrders());
     EXPECT_EQ(0, worker1->getUndeliveredOrders());
-    EXPECT_TRUE(*worker1 == *(workerM.getLessBusyWorker("Head Office")));
+    EXPECT_TRUE(*worker1 == *(workerM.getLessBusyWorker(Location("Head Office"))));
 
     Order* order2 = orderM.add(client2);
 
     EXPECT_EQ(1, worker1->getUndeliveredOrders());
     EXPECT_EQ(1, worker2->getUndeliveredOrders());
-    EXPECT_TRUE(*worker2 == *(workerM.getLessBusyWorker("Head Office")));
+    EXPECT_TRUE(*worker2 == *(workerM.getLessBusyWorker(Location("Head Office"))));
 
     orderM.deliver(order1, 5);
     orderM.deliver(order2, 3);
@@ -526,7 +1015,44 @@ TEST(WorkerManager, get_less_busy_worker){
     orderM.add(client1, worker4);
     orderM.add(client1, worker4);
 
-    EXPECT_THROW(workerM.getLessBusyWorker(Order::DEFAULT_LOCATION), AllWorkersAreBusy);
+    EXPECT_THROW(workerM.getLessBusyWorker(Location(Order::DEFAULT_LOCATION)), AllWorkersAreBusy);
+}
+
+TEST(WorkerManager, get_less_busy_worker_by_location){
+    LocationManager locationM;
+    locationM.add("Porto");
+    locationM.add("Lisboa");
+    ProductManager productM;
+    ClientManager clientM;
+    WorkerManager workerM(&locationM);
+    OrderManager orderM(&productM, &clientM, &workerM, &locationM);
+
+    Client* client = clientM.add("Ricardo Macedo");
+    Worker* worker1 = workerM.add("Porto", "Jose Figueiras", 111111111);
+    Worker* worker2 = workerM.add("Porto", "Madalena Faria", 222222222);
+    Worker* worker3 = workerM.add(Order::DEFAULT_LOCATION, "Manuel Pimenta", 333333333);
+
+    EXPECT_EQ(worker2, workerM.getLessBusyWorker(Location("Porto")));
+    EXPECT_EQ(worker3, workerM.getLessBusyWorker(Location(Order::DEFAULT_LOCATION)));
+    EXPECT_EQ(worker3, workerM.getLessBusyWorker(Location("Lisboa")));
+
+    Order* order = orderM.add(client, "Porto");
+
+    EXPECT_EQ(worker2, order->getWorker());
+    EXPECT_EQ(worker1, workerM.getLessBusyWorker(Location("Porto")));
+
+    orderM.add(client, worker3);
+
+    EXPECT_EQ(worker1, workerM.getLessBusyWorker(Location("Lisboa")));
+
+    orderM.remove(order);
+
+    EXPECT_EQ(worker2, workerM.getLessBusyWorker(Location("Porto")));
+
+    workerM.remove(worker2);
+
+    EXPECT_EQ(worker1, workerM.getLessBusyWorker(Location("Porto")));
+    delete worker2;
 }
 
 TEST(WorkerManager, set_salary){
@@ -545,11 +1071,12 @@ TEST(WorkerManager, set_salary){
     EXPECT_FLOAT_EQ(849, workerM.getWorker(worker2->getTaxId())->getSalary());
 
     position = 0;
-    workerM.setSalary(position, 950); // for worker1
+    Worker* first = workerM.get(position); // iteration order of the hash table is unspecified
+    workerM.setSalary(position, 950);
 
     position = 3;
     EXPECT_THROW(workerM.setSalary(position, 950), InvalidPersonPosition);
-    EXPECT_FLOAT_EQ(950, worker2->getSalary());
+    EXPECT_FLOAT_EQ(950, first->getSalary());
 }
 
 TEST(WorkerManager, add_worker){
@@ -639,6 +1166,33 @@ TEST(WorkerManager, remove_worker_by_position){
     EXPECT_THROW(workerM.get(positionToRemove), InvalidPersonPosition);
 }
 
+TEST(WorkerManager, many_workers){
+    LocationManager locationM;
+    WorkerManager workerM(&locationM);
+    std::vector<Worker*> workers;
+    for (unsigned long i = 0; i < 200; ++i)
+        workers.push_back(workerM.add(Order::DEFAULT_LOCATION, "Worker", 100000000 + i));
+
+    EXPECT_EQ(200, workerM.getAll().size());
+    workerM.add(Order::DEFAULT_LOCATION, "Other Worker", 100000000);
+    EXPECT_EQ(200, workerM.getAll().size());
+
+    for (unsigned long i = 0; i < 200; i += 2) workerM.remove(workers.at(i));
+
+    EXPECT_EQ(100, workerM.getAll().size());
+    for (unsigned long i = 0; i < 200; ++i) {
+        Worker worker(Order::DEFAULT_LOCATION, "Other Worker", 100000000 + i);
+        EXPECT_EQ(i % 2 == 1, workerM.has(&worker));
+    }
+
+    unsigned count = 0;
+    for (Worker* worker : workerM.getAll()) {
+        EXPECT_EQ(1, worker->getTaxId() % 2);
+        ++count;
+    }
+    EXPECT_EQ(100, count);
+}
+
 TEST(WorkerManager, read){
     LocationManager locationM;
     locationM.add("Lisboa");
@@ -755,6 +1309,18 @@ TEST(ProductManager, get_by_string_and_price){
 
     currentProduct = productM.get("Tarte de bolacha", 3.40);
     EXPECT_TRUE(*static_cast<Product*>(cake) == *currentProduct);
+
+    Bread* bigBread = productM.addBread("Pao de sementes", 1.5, false);
+
+    EXPECT_EQ(bread, productM.get("Pao de sementes", 0.8));
+    EXPECT_EQ(bigBread, productM.get("Pao de sementes", 1.5));
+    EXPECT_THROW(productM.get("Pao de sementes", 1.0), ProductDoesNotExist);
+
+    productM.remove(bread);
+
+    EXPECT_THROW(productM.get("Pao de sementes", 0.8), ProductDoesNotExist);
+    EXPECT_EQ(bigBread, productM.get("Pao de sementes", 1.5));
+    delete bread;
 }
 
 TEST(ProductManager, get_used){
@@ -899,6 +1465,93 @@ TEST(ProductManager, remove_by_position){
     EXPECT_TRUE(productM.getAll().empty());
 }
 
+TEST(ProductManager, many_products_by_position){
+    ProductManager productM;
+    for (int i = 0; i < 200; ++i) productM.addBread("Pao " + std::to_string(1000 + i), 0.5);
+
+    std::vector<Product*> products = productM.getAll();
+    ASSERT_EQ(200, products.size());
+    for (unsigned long i = 0; i < products.size(); ++i) EXPECT_EQ(products.at(i), productM.get(i));
+    EXPECT_EQ("Pao 1000", productM.get(0)->getName());
+    EXPECT_EQ("Pao 1199", productM.get(199)->getName());
+
+    for (unsigned long i = 0; i < 100; ++i) productM.remove(i);
+
+    products = productM.getAll();
+    ASSERT_EQ(100, products.size());
+    for (unsigned long i = 0; i < products.size(); ++i) {
+        EXPECT_EQ("Pao " + std::to_string(1001 + 2*i), products.at(i)->getName());
+        EXPECT_EQ(products.at(i), productM.get(i));
+    }
+    EXPECT_THROW(productM.get(100), InvalidProductPosition);
+}
+
+TEST(ProductManager, update_inclusions){
+    ProductManager productM;
+    Bread* bread1 = productM.addBread("Pao de agua", 0.2);
+    Bread* bread2 = productM.addBread("Pao de centeio", 0.3);
+    Cake* cake = productM.addCake("Bolo de chocolate", 1.2);
+    unsigned position = 0;
+
+    EXPECT_EQ(cake, productM.get(position));
+    EXPECT_EQ(bread1, productM.get(++position));
+
+    bread1->addInclusion();
+    productM.update(bread1, 0);
+    position = 0;
+
+    EXPECT_TRUE(productM.has(bread1));
+    EXPECT_EQ(cake, productM.get(position));
+    EXPECT_EQ(bread2, productM.get(++position));
+    EXPECT_EQ(bread1, productM.get(++position));
+
+    std::unordered_map<Product*, unsigned> previousInclusions = {{bread2, 0}, {cake, 0}};
+    bread2->addInclusion(); bread2->addInclusion();
+    cake->addInclusion();
+    productM.update(previousInclusions);
+    position = 0;
+
+    EXPECT_EQ(cake, productM.get(position));
+    EXPECT_EQ(bread1, productM.get(++position));
+    EXPECT_EQ(bread2, productM.get(++position));
+    EXPECT_EQ(3, productM.getAll().size());
+
+    Bread unknown("Pao de forma", 1);
+    unknown.addInclusion();
+    EXPECT_THROW(productM.update(&unknown, 0), ProductDoesNotExist);
+}
+
+TEST(ProductManager, update_many_inclusions){
+    ProductManager productM;
+    std::vector<Bread*> breads;
+    for (int i = 0; i < 100; ++i) breads.push_back(productM.addBread("Pao " + std::to_string(1000 + i), 0.5));
+
+    std::unordered_map<Product*, unsigned> previousInclusions;
+    for (unsigned i = 0; i < 100; i += 2){
+        previousInclusions[breads.at(i)] = 0;
+        for (unsigned j = 0; j < i % 3 + 1; ++j) breads.at(i)->addInclusion();
+    }
+    productM.update(previousInclusions);
+
+    std::vector<Product*> products = productM.getAll();
+    ASSERT_EQ(100, products.size());
+    for (unsigned long i = 0; i < products.size(); ++i) EXPECT_EQ(products.at(i), productM.get(i));
+    for (unsigned long i = 1; i < products.size(); ++i)
+        EXPECT_LE(products.at(i - 1)->getTimesIncluded(), products.at(i)->getTimesIncluded());
+    EXPECT_EQ(breads.at(1), productM.get(0));
+    EXPECT_EQ(breads.at(98), productM.get(99));
+
+    Bread unknown("Pao de forma", 1);
+    previousInclusions = {{&unknown, 0}};
+    for (unsigned i = 1; i < 100; i += 2){
+        previousInclusions[breads.at(i)] = 0;
+        breads.at(i)->addInclusion();
+    }
+    unknown.addInclusion();
+    EXPECT_THROW(productM.update(previousInclusions), ProductDoesNotExist);
+    EXPECT_EQ(products, productM.getAll());
+}
+
 TEST(ProductManager, read){
     ProductManager productM;
 
@@ -921,6 +1574,29 @@ TEST(ProductManager, read){
     EXPECT_FALSE(bread->isSmall());
 }
 
+TEST(ProductManager, read_windows_line_endings){
+    std::string path = "products_crlf.txt";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "CAKES\r\nBolo-de-bolacha 2.2 Pie\r\n\r\n" << util::SEPARATOR << "BREADS\r\nPao-da-avo 1.5 small";
+    }
+    ProductManager productM;
+    productM.read(path);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(1, productM.getCakes().size());
+    Cake* cake = *productM.getCakes().begin();
+    EXPECT_EQ("Bolo de bolacha", cake->getName());
+    EXPECT_FLOAT_EQ(2.2, cake->getPrice());
+    EXPECT_EQ("Pie", cake->getCategory());
+
+    ASSERT_EQ(1, productM.getBreads().size());
+    Bread* bread = *productM.getBreads().begin();
+    EXPECT_EQ("Pao da avo", bread->getName());
+    EXPECT_FLOAT_EQ(1.5, bread->getPrice());
+    EXPECT_TRUE(bread->isSmall());
+}
+
 TEST(ProductManager, write){
     std::string path = "../../test/data/products.txt";
     ProductManager productMInitial; productMInitial.read(path);
@@ -950,6 +1626,53 @@ TEST(ProductManager, write){
     productMInitial.write(path);
 }
 
+TEST(ProductManager, bestsellers){
+    LocationManager locationM;
+    ProductManager productM; ClientManager clientM; WorkerManager workerM(&locationM);
+    OrderManager orderM(&productM, &clientM, &workerM, &locationM);
+    Worker* worker = workerM.add(Order::DEFAULT_LOCATION, "Josue Tome", 928);
+    Client* client = clientM.add("Fernando Castro");
+    Bread* smallBread = productM.addBread("Pao de sementes", 0.8, true);
+    Bread* bigBread = productM.addBread("Pao da avo", 1.5, false);
+    Cake* pie = productM.addCake("Tarte de bolacha", 3.40, CakeCategory::PIE);
+    Cake* otherPie = productM.addCake("Tarte de maca", 3.10, CakeCategory::PIE);
+    productM.addCake("Bolo de arroz", 1, CakeCategory::SPONGE);
+
+    EXPECT_TRUE(productM.getBestsellers(3).empty());
+
+    for (unsigned i = 0; i < 4; ++i){
+        Order* order = orderM.add(client, worker);
+        orderM.addProduct(order, pie);
+        if (i < 3) orderM.addProduct(order, smallBread, 5);
+        if (i < 2) orderM.addProduct(order, otherPie);
+        if (i < 1) orderM.addProduct(order, bigBread);
+    }
+
+    EXPECT_EQ((std::vector<Product*>{pie, smallBread}), productM.getBestsellers(2));
+    EXPECT_EQ((std::vector<Product*>{pie, smallBread, otherPie, bigBread}), productM.getBestsellers(10));
+    EXPECT_EQ((std::vector<Cake*>{pie, otherPie}), productM.getBestCakes(3, CakeCategory::PIE));
+    EXPECT_TRUE(productM.getBestCakes(3, CakeCategory::SPONGE).empty());
+    EXPECT_TRUE(productM.getBestCakes(3, CakeCategory::CRUNCHY).empty());
+    EXPECT_EQ((std::vector<Bread*>{bigBread}), productM.getBestBreads(3, false));
+
+    // an order holding the product twice includes it once
+    Order* order = orderM.add(client, worker);
+    orderM.addProduct(order, otherPie);
+    orderM.addProduct(order, otherPie);
+    EXPECT_EQ((std::vector<Cake*>{pie, otherPie}), productM.getBestCakes(3, CakeCategory::PIE));
+    Order* secondOrder = orderM.add(client, worker);
+    orderM.addProduct(secondOrder, otherPie);
+    orderM.addProduct(orderM.add(client, worker), otherPie);
+    EXPECT_EQ((std::vector<Cake*>{otherPie, pie}), productM.getBestCakes(3, CakeCategory::PIE));
+
+    orderM.removeProduct(order, otherPie);
+    orderM.removeProduct(secondOrder, 0ul);
+    EXPECT_EQ(pie, productM.getBestCakes(1, CakeCategory::PIE).at(0));
+    productM.remove(pie);
+    EXPECT_EQ((std::vector<Cake*>{otherPie}), productM.getBestCakes(3, CakeCategory::PIE));
+    EXPECT_EQ(smallBread, productM.getBestsellers(1).at(0));
+}
+
 TEST(OrderManager, has){
     LocationManager locationM;
     ProductManager productM; ClientManager clientM; WorkerManager workerM(&locationM);
@@ -1060,9 +1783,9 @@ TEST(OrderManager, get_location_orders){
     Order* order2 = orderM.add(client, worker, location, date2);
     unsigned position = 0;
 
-    std::priority_queue<OrderEntry> ordersEntry = orderM.get(location);
+    std::priority_queue<OrderEntry> ordersEntry = orderM.get(Location(location));
 
-    EXPECT_EQ(2, orderM.get(location).size());
+    EXPECT_EQ(2, orderM.get(Location(location)).size());
     EXPECT_TRUE(*order1 == *ordersEntry.top().getOrder());
 
     ordersEntry.pop();
@@ -1195,6 +1918,17 @@ TEST(OrderManager, remove_order_by_position){
 
     EXPECT_EQ(3, worker->getUndeliveredOrders());
     EXPECT_EQ(2, orderM.getAll().size());
+
+    // delivered orders are kept, so that the delivered totals stay right
+    Order* delivered = orderM.get(position);
+    orderM.deliver(delivered, 4, false);
+    unsigned long deliveredPosition = 0;
+    while (orderM.get(deliveredPosition) != delivered) ++deliveredPosition;
+
+    EXPECT_THROW(orderM.remove(deliveredPosition), OrderWasAlreadyDelivered);
+    EXPECT_EQ(2, orderM.getAll().size());
+    EXPECT_EQ(1, orderM.getDeliveredCount());
+    EXPECT_EQ(2, worker->getUndeliveredOrders());
 }
 
 TEST(OrderManager, sort_orders){
@@ -1224,6 +1958,70 @@ TEST(OrderManager, sort_orders){
     EXPECT_TRUE(*order4 == *orderM.get(++position));
 }
 
+TEST(OrderManager, order_ids){
+    LocationManager locationM;
+    ProductManager productM;
+    ClientManager clientM;
+    WorkerManager workerM(&locationM);
+    OrderManager orderM(&productM, &clientM, &workerM, &locationM);
+
+    Client* client = clientM.add("Fernando Castro");
+    Worker* worker = workerM.add(Order::DEFAULT_LOCATION, "Josue Tome", 928);
+    Order unmanaged(*client, *worker);
+    std::vector<Order*> orders;
+    for (int i = 0; i < 50; ++i) orders.push_back(orderM.add(client, worker));
+
+    EXPECT_EQ(0, unmanaged.getId());
+    EXPECT_EQ(1, orders.front()->getId());
+    EXPECT_EQ(50, orders.back()->getId());
+    EXPECT_TRUE(orderM.has(orders.at(25)));
+    for (unsigned long i = 0; i < orders.size(); ++i) EXPECT_EQ(orders.at(i), orderM.get(i));
+
+    unsigned long id = orders.at(10)->getId();
+    orderM.deliver(orders.at(10), 5);
+    EXPECT_EQ(id, orders.at(10)->getId());
+    EXPECT_EQ(orders.at(10), orderM.get(49));
+
+    orderM.remove(orders.at(20));
+    EXPECT_EQ(49, orderM.getOrders().size());
+    EXPECT_EQ(orders.at(21), orderM.get(19));
+    EXPECT_EQ(51, orderM.add(client, worker)->getId());
+}
+
+TEST(OrderManager, reprioritize_orders){
+    LocationManager locationM;
+    ProductManager productM;
+    ClientManager clientM;
+    WorkerManager workerM(&locationM);
+    OrderManager orderM(&productM, &clientM, &workerM, &locationM);
+
+    Client* client1 = clientM.add("Fernando Castro");
+    Client* client2 = clientM.add("Catia Fernandes");
+    Worker* worker = workerM.add(Order::DEFAULT_LOCATION, "Josue Tome", 928);
+
+    Order* order1 = orderM.add(client1, worker);
+    Order* order2 = orderM.add(client2, worker);
+    Order* order3 = orderM.add(client1, worker);
+    unsigned position = 0;
+
+    EXPECT_EQ(order1, orderM.get(position));
+
+    orderM.deliver(order1, 5);
+
+    EXPECT_EQ(order2, orderM.get(position));
+    EXPECT_EQ(order3, orderM.get(++position));
+    EXPECT_EQ(order1, orderM.get(++position));
+
+    client2->addEvaluation(5);
+    client2->addDiscount();
+    orderM.reprioritize(client2);
+    position = 0;
+
+    EXPECT_EQ(order3, orderM.get(position));
+    EXPECT_EQ(order2, orderM.get(++position));
+    EXPECT_EQ(order2, orderM.get(client2).top().getOrder());
+}
+
 TEST(OrderManager, get_order_by_position){
     LocationManager locationM;
     ProductManager productM;
@@ -1352,6 +2150,47 @@ TEST(OrderManager, set_delivery_location){
 
     EXPECT_EQ("Lisboa", order->getDeliverLocation());
     EXPECT_TRUE(*worker2 == *order->getWorker());
+    EXPECT_TRUE(orderM.get(worker1).empty());
+    EXPECT_EQ(order, orderM.get(0, nullptr, worker2));
+    EXPECT_TRUE(orderM.get(Location(Order::DEFAULT_LOCATION)).empty());
+    EXPECT_EQ(order, orderM.get(Location("Lisboa")).top().getOrder());
+}
+
+TEST(OrderManager, orders_indexes){
+    LocationManager locationM;
+    locationM.add("Lisboa");
+    ProductManager productM;
+    ClientManager clientM;
+    WorkerManager workerM(&locationM);
+    OrderManager orderM(&productM, &clientM, &workerM, &locationM);
+
+    Client* client1 = clientM.add("Fernando Castro");
+    Client* client2 = clientM.add("Catia Fernandes");
+    Worker* worker1 = workerM.add(Order::DEFAULT_LOCATION, "Josue Tome", 928);
+    Worker* worker2 = workerM.add("Lisboa", "Marta Loureiro", 900);
+
+    Order* order1 = orderM.add(client1, worker1);
+    Order* order2 = orderM.add(client2, worker2, "Lisboa");
+    Order* order3 = orderM.add(client1, worker2, "Lisboa");
+
+    EXPECT_EQ(2, orderM.getOrders(client1).size());
+    EXPECT_EQ(1, orderM.getOrders(client2).size());
+    EXPECT_EQ(1, orderM.getOrders(worker1).size());
+    EXPECT_EQ(2, orderM.getOrders(Location("Lisboa")).size());
+    EXPECT_EQ(order3, orderM.get(1, client1));
+    EXPECT_EQ(order3, orderM.get(1, nullptr, worker2));
+    EXPECT_THROW(orderM.get(2, client1), InvalidOrderPosition);
+
+    orderM.deliver(order1, 4);
+
+    EXPECT_EQ(order3, orderM.get(0, client1));
+    EXPECT_EQ(order1, orderM.get(1, client1));
+
+    orderM.remove(order2);
+
+    EXPECT_TRUE(orderM.getOrders(client2).empty());
+    EXPECT_EQ(1, orderM.getOrders(worker2).size());
+    EXPECT_EQ(1, orderM.getOrders(Location("Lisboa")).size());
 }
 
 TEST(OrderManager, read){
@@ -1382,7 +2221,7 @@ TEST(OrderManager, read){
     EXPECT_TRUE(currentOrder->wasDelivered());
     EXPECT_EQ(4, currentOrder->getClientEvaluation());
 
-    std::map<Product*, unsigned int, ProductSmaller> products = orderM.getAll().top().getOrder()->getProducts();
+    const OrderProducts& products = orderM.getAll().top().getOrder()->getProducts();
     std::string productName = "Pao da avo", productCategory = "Big Bread";
     float productPrice = 1;
     unsigned int productQuantity = 1;
@@ -1409,6 +2248,33 @@ TEST(OrderManager, read){
     EXPECT_TRUE(it != products.end());
 }
 
+TEST(OrderManager, read_repeated_products){
+    std::string path = "orders_repeated.txt";
+    LocationManager locationM;
+    locationM.add("Porto");
+    ProductManager productM; ClientManager clientM; WorkerManager workerM(&locationM);
+    OrderManager orderM(&productM, &clientM, &workerM, &locationM);
+    Bread* bread = productM.addBread("Pao de deus", 0.5);
+    Cake* cake = productM.addCake("Bolo rei", 12);
+    clientM.add("Joao Miguel", 123823);
+    workerM.add("Porto", "Mario Cordeiro", 823823);
+
+    std::ofstream file(path);
+    file << "123823 823823 23/05/2019 21:30 Porto\nPao-de-deus 0.5 1\nBolo-rei 12 1\nPao-de-deus 0.5 1\n"
+         << util::SEPARATOR;
+    file.close();
+    orderM.read(path);
+    std::remove(path.c_str());
+
+    Order* order = orderM.getAll().top().getOrder();
+    EXPECT_EQ(2, order->getProducts().find(bread)->second);
+    EXPECT_EQ(1, order->getProducts().find(cake)->second);
+    EXPECT_EQ(1, bread->getTimesIncluded());
+    EXPECT_TRUE(productM.has(bread));
+    EXPECT_TRUE(productM.has(cake));
+    EXPECT_EQ(bread, productM.getBestsellers(1).front());
+}
+
 TEST(OrderManager, write){
     std::string path = "../../test/data/orders.txt";
     LocationManager locationMInit;
@@ -1454,6 +2320,191 @@ TEST(OrderManager, write){
     orderMInit.write(path);
 }
 
+TEST(OrderManager, write_each_order_once){
+    std::string path = "orders_export.txt";
+    LocationManager locationM;
+    ProductManager productM; ClientManager clientM; WorkerManager workerM(&locationM);
+    OrderManager orderM(&productM, &clientM, &workerM, &locationM);
+    locationM.add("Vila Real");
+    Bread* bread = productM.addBread("Pao de deus", 0.35f);
+    Cake* cake = productM.addCake("Bolo rei", 12.5);
+    Worker* worker = workerM.add("Vila Real", "Mario Cordeiro", 823823);
+    for (unsigned long i = 0; i < 500; ++i){
+        Client* client = clientM.add("Cliente " + std::to_string(i), 100000 + i);
+        Order* order = orderM.add(client, worker, "Vila Real", Date(1 + i % 28, 1 + i % 12, 2021, i % 24, i % 60));
+        orderM.addProduct(order, bread, 1 + i % 5);
+        if (i % 2) orderM.addProduct(order, cake);
+        if (i % 3 == 0) orderM.deliver(order, i % 6, false);
+    }
+
+    orderM.write(path);
+
+    std::ifstream file(path);
+    std::string line;
+    std::set<std::string> details;
+    unsigned separators = 0, products = 0;
+    bool readDetails = true;
+    while (std::getline(file, line)){
+        if (line.front() == '-') { ++separators; readDetails = true; }
+        else if (readDetails) { details.insert(line); readDetails = false; }
+        else ++products;
+    }
+    EXPECT_EQ(500, separators);
+    EXPECT_EQ(500, details.size());
+    EXPECT_EQ(750, products);
+    EXPECT_EQ(1, details.count("100000 823823 01/01/2021 00:00 Vila-Real 0"));
+    EXPECT_EQ(1, details.count("100001 823823 02/02/2021 01:01 Vila-Real"));
+
+    // numbers are formatted as the streams do
+    std::ifstream reread(path);
+    std::string contents((std::istreambuf_iterator<char>(reread)), std::istreambuf_iterator<char>());
+    std::ostringstream price;
+    price << "Pao-de-deus " << 0.35f << " 2\n";
+    EXPECT_NE(std::string::npos, contents.find(price.str()));
+    EXPECT_NE(std::string::npos, contents.find("Bolo-rei 12.5 1\n"));
+    std::remove(path.c_str());
+}
+
+TEST(OrderManager, analytics){
+    LocationManager locationM;
+    ProductManager productM; ClientManager clientM; WorkerManager workerM(&locationM);
+    OrderManager orderM(&productM, &clientM, &workerM, &locationM);
+    locationM.add("Porto");
+    Bread* bread = productM.addBread("Pao de deus", 1);
+    Cake* cake = productM.addCake("Bolo rei", 3);
+    Worker* worker = workerM.add("Porto", "Mario Cordeiro", 823823);
+    Client* client = clientM.add("Joao Miguel", 123823);
+
+    // 10/03/2021 was a Wednesday; the last order is before all the others
+    const Date dates[] = {Date(10, 3, 2021, 9, 0), Date(10, 3, 2021, 23, 59), Date(14, 3, 2021),
+                          Date(15, 3, 2021), Date(2, 4, 2021), Date(20, 12, 2019)};
+    const Location porto("Porto"), headOffice(Order::DEFAULT_LOCATION);
+    for (unsigned i = 0; i < 6; ++i){
+        Order* order = orderM.add(client, worker, i % 2 ? headOffice : porto, dates[i]);
+        orderM.addProduct(order, bread, 2);
+        if (i % 3 == 0) orderM.addProduct(order, cake);
+        orderM.deliver(order, static_cast<int>(i), false);
+    }
+    orderM.add(client, worker, "Porto", Date(10, 3, 2021));
+
+    const OrderAnalytics& analytics = orderM.getAnalytics();
+    AnalyticsTotals day = analytics.get(Date(10, 3, 2021), Date(10, 3, 2021));
+    EXPECT_EQ(2, day.orders);
+    EXPECT_FLOAT_EQ(5 + 2, day.revenue);
+    EXPECT_FLOAT_EQ(0.5f, day.getMeanEvaluation());
+
+    AnalyticsTotals porto2021 = analytics.get(Date(1, 1, 2021), Date(31, 12, 2021), &porto);
+    EXPECT_EQ(3, porto2021.orders);
+    EXPECT_EQ(0 + 2 + 4, porto2021.evaluationsSum);
+    EXPECT_FLOAT_EQ(3, analytics.get(Date(1, 1, 2021), Date(31, 12, 2021), &porto, ProductType::CAKE).revenue);
+    EXPECT_FLOAT_EQ(6, analytics.get(Date(1, 1, 2021), Date(31, 12, 2021), &porto, ProductType::BREAD).revenue);
+    EXPECT_EQ(2, analytics.get(Date(1, 1, 2019), Date(31, 12, 2021), nullptr, ProductType::CAKE).orders);
+    EXPECT_EQ(1, analytics.get(Date(1, 12, 2019), Date(31, 12, 2019)).orders);
+
+    std::vector<AnalyticsTotals> weeks = analytics.getSeries(Date(10, 3, 2021), Date(3, 4, 2021), TimeBucket::WEEK);
+    ASSERT_EQ(4, weeks.size());
+    EXPECT_EQ("10/03/2021", weeks.at(0).from.getCalendarDay());
+    EXPECT_EQ("15/03/2021", weeks.at(1).from.getCalendarDay());
+    EXPECT_EQ(3, weeks.at(0).orders);
+    EXPECT_EQ(1, weeks.at(1).orders);
+    EXPECT_EQ(0, weeks.at(2).orders);
+    EXPECT_EQ(1, weeks.at(3).orders);
+
+    std::vector<AnalyticsTotals> months = analytics.getSeries(Date(1, 11, 2019), Date(30, 4, 2021), TimeBucket::MONTH);
+    ASSERT_EQ(18, months.size());
+    EXPECT_EQ("01/12/2019", months.at(1).from.getCalendarDay());
+    EXPECT_EQ(1, months.at(1).orders);
+    EXPECT_EQ(4, months.at(16).orders);
+    EXPECT_EQ(1, months.at(17).orders);
+}
+
+TEST(OrderManager, delivery_sketches){
+    LocationManager locationM;
+    ProductManager productM; ClientManager clientM; WorkerManager workerM(&locationM);
+    OrderManager orderM(&productM, &clientM, &workerM, &locationM);
+    locationM.add("Porto");
+    Bread* bread = productM.addBread("Pao de deus", 0.5);
+    Worker* worker = workerM.add("Porto", "Mario Cordeiro", 823823);
+    Worker* otherWorker = workerM.add(Order::DEFAULT_LOCATION, "Ana Castro", 323823);
+    Client* client = clientM.add("Joao Miguel", 123823);
+
+    EXPECT_EQ(0, orderM.getSketches(worker).value.getCount());
+    EXPECT_EQ(0, orderM.getSketches().latency.getQuantile(0.5));
+
+    // 2000 orders at Porto with values from 0.5 to 1000 euros, delivered in 1 to 100 minutes
+    for (unsigned i = 1; i <= 2000; ++i){
+        Order* order = orderM.add(client, worker, "Porto", Date(1, 1, 2021));
+        orderM.addProduct(order, bread, i);
+        orderM.deliver(order, 5, false, static_cast<int>(i % 100 + 1));
+    }
+    Order* order = orderM.add(client, otherWorker, Order::DEFAULT_LOCATION, Date(1, 1, 2021));
+    orderM.addProduct(order, bread, 4000);
+    orderM.deliver(order, 5, false, 1000);
+
+    const DeliverySketches& porto = orderM.getSketches(Location("Porto"));
+    EXPECT_EQ(2000, porto.value.getCount());
+    EXPECT_NEAR(500, porto.value.getQuantile(0.5), 20);
+    EXPECT_NEAR(950, porto.value.getQuantile(0.95), 20);
+    EXPECT_FLOAT_EQ(1000, porto.value.getQuantile(1));
+    EXPECT_NEAR(95, porto.latency.getQuantile(0.95), 3);
+    EXPECT_EQ(2000, orderM.getSketches(worker).latency.getCount());
+    EXPECT_FLOAT_EQ(1000, orderM.getSketches(otherWorker).latency.getQuantile(0.5));
+
+    DeliverySketches all = orderM.getSketches();
+    EXPECT_EQ(2001, all.value.getCount());
+    EXPECT_FLOAT_EQ(2000, all.value.getQuantile(1));
+    EXPECT_NEAR(500, all.value.getQuantile(0.5), 20);
+
+    // the sketches of a removed worker go with it, while its deliveries stay on the ones of their location
+    orderM.removeWorker(otherWorker);
+    EXPECT_FALSE(workerM.has(otherWorker));
+    EXPECT_EQ(0, orderM.getSketches(otherWorker).latency.getCount());
+    EXPECT_EQ(2001, orderM.getSketches().value.getCount());
+    EXPECT_THROW(orderM.removeWorker(otherWorker), PersonDoesNotExist);
+}
+
+TEST(Location, interning){
+    Location porto("Porto"), samePorto(std::string("Porto")), braga("Braga");
+
+    EXPECT_TRUE(porto == samePorto);
+    EXPECT_TRUE(porto != braga);
+    EXPECT_EQ(porto.getId(), samePorto.getId());
+    EXPECT_NE(porto.getId(), braga.getId());
+    EXPECT_EQ(&porto.getName(), &samePorto.getName());
+    EXPECT_EQ("Porto", porto.getName());
+
+    LocationManager locationM;
+    WorkerManager workerM(&locationM);
+    locationM.add("Porto");
+    Worker* worker = workerM.add("Porto", "Mario Cordeiro", 823823);
+    EXPECT_TRUE(worker->getLocationHandle() == porto);
+    EXPECT_EQ(&porto.getName(), &worker->getLocation());
+    EXPECT_EQ(worker, workerM.getLessBusyWorker(porto));
+}
+
+TEST(Location, find){
+    EXPECT_EQ(nullptr, Location::find("Nowhere"));
+    Location porto("Porto");
+    ASSERT_NE(nullptr, Location::find("Porto"));
+    EXPECT_TRUE(*Location::find("Porto") == porto);
+
+    // names which aren't store locations are only looked up, never interned
+    LocationManager locationM;
+    ProductManager productM;
+    ClientManager clientM;
+    WorkerManager workerM(&locationM);
+    OrderManager orderM(&productM, &clientM, &workerM, &locationM);
+    Client* client = clientM.add("Fernando Castro");
+    Worker* worker = workerM.add(Order::DEFAULT_LOCATION, "Josue Tome", 928);
+    Order* order = orderM.add(client, worker);
+    EXPECT_THROW(orderM.add(client, worker, "Nowhere"), LocationDoesNotExist);
+    EXPECT_THROW(orderM.get(client, worker, "Nowhere", Date(1, 1, 2020)), OrderDoesNotExist);
+    EXPECT_THROW(orderM.setDeliveryLocation(order, "Nowhere"), LocationDoesNotExist);
+    EXPECT_THROW(workerM.add("Nowhere", "Marta Loureiro", 900), LocationDoesNotExist);
+    EXPECT_EQ(nullptr, Location::find("Nowhere"));
+    EXPECT_EQ(Order::DEFAULT_LOCATION, order->getDeliverLocation());
+}
+
 TEST(LocationManager, has){
     LocationManager locationM;
     std::string location1 = "Braga";